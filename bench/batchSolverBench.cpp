@@ -0,0 +1,103 @@
+// Compares the bit-sliced BatchSolver (scalar and AVX2 kernels) with solving boards one at a time with FixedSolver.
+// The two kernels must give the same results, and every solution is checked against Solver. Returns 1 if any check
+// fails.
+
+#include "../src/game/batchSolver.h"
+#include "../src/game/fixedSolver.h"
+#include "../src/game/generator.h"
+#include "../src/game/solver.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @brief Checks every BatchSolver result against Solver: both must agree on solvability, and each solution must
+/// clear its board with the reported number of presses.
+/// @return The number of boards that failed
+static int check(int size, const std::vector<uint64_t> &boards, const std::vector<uint64_t> &solutions,
+                 const std::vector<int> &pressCounts) {
+    Solver solver(size, size);
+    Board presses(size, size);
+    int failures = 0;
+    for (size_t i = 0; i < boards.size(); i++) {
+        Board board = BatchSolver::unpack(boards[i], size, size);
+        bool solvable = pressCounts[i] >= 0;
+        if (solvable != solver.solve(board, presses)) {
+            std::printf("FAILED: BatchSolver and Solver disagree on whether a %dx%d board is solvable\n", size, size);
+            failures++;
+            continue;
+        }
+        if (!solvable)
+            continue;
+        Board solution = BatchSolver::unpack(solutions[i], size, size);
+        for (int row = 0; row < size; row++)
+            board.pressRow(row, solution.getRow(row));
+        if (!board.isSolved() || solution.getLitCount() != pressCounts[i]) {
+            std::printf("FAILED: BatchSolver solution of a %dx%d board is wrong\n", size, size);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+template<int N>
+static int compare(Generator &generator) {
+    const size_t count = 1 << 20;
+    std::vector<uint64_t> boards(count), solutions(count), scalarSolutions;
+    std::vector<int> pressCounts(count), scalarPressCounts;
+    // every fourth board is random, so boards with no solution are covered too
+    for (size_t i = 0; i < count; i++) {
+        boards[i] = i % 4 ? BatchSolver::pack(generator.generate(N, N))
+                          : generator.next() & ((uint64_t(1) << (N * N)) - 1);
+    }
+
+    uint64_t checksum = 0, presses = 0;
+    Clock::time_point start = Clock::now();
+    for (uint64_t board : boards) {
+        FixedSolver<N, N>::solve(FixedBoard<N, N>(board), presses);
+        checksum += popcount64(presses);
+    }
+    double single = secondsSince(start);
+    std::printf("%dx%d  FixedSolver, one at a time %8.1f M boards/s  (checksum %llu)\n", N, N,
+                count / single / 1e6, static_cast<unsigned long long>(checksum));
+
+    BatchSolver solver(N, N);
+    for (bool useSimd : {false, true}) {
+        solver.setUseSimd(useSimd);
+        if (useSimd && !solver.isUsingSimd())
+            continue;
+        start = Clock::now();
+        solver.solve(boards.data(), count, solutions.data(), pressCounts.data());
+        double batch = secondsSince(start);
+        checksum = 0;
+        for (int pressCount : pressCounts)
+            checksum += pressCount;
+        std::printf("%dx%d  BatchSolver, %-6s         %8.1f M boards/s  (checksum %llu)\n", N, N,
+                    useSimd ? "avx2" : "scalar", count / batch / 1e6, static_cast<unsigned long long>(checksum));
+
+        if (!useSimd) {
+            scalarSolutions = solutions;
+            scalarPressCounts = pressCounts;
+        } else if (solutions != scalarSolutions || pressCounts != scalarPressCounts) {
+            std::printf("FAILED: %dx%d avx2 and scalar results differ\n", N, N);
+            return 1;
+        }
+    }
+    return check(N, boards, scalarSolutions, scalarPressCounts);
+}
+
+int main() {
+    Generator generator(99);
+    int failures = compare<5>(generator) + compare<7>(generator);
+    if (failures) {
+        std::printf("%d checks FAILED\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Compares the compile-time specialised FixedSolver with the runtime Solver on the board sizes the game ships, and
+// checks that both agree. Returns 1 if any check fails.
+
+#include "../src/game/fixedSolver.h"
+#include "../src/game/generator.h"
+#include "../src/game/solver.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @brief Checks FixedSolver against Solver on generated (solvable) and random (often unsolvable) boards: both must
+/// agree on solvability, and every FixedSolver solution must clear its board.
+/// @return The number of boards that failed
+template<int N, int M>
+static int check(Generator &generator) {
+    Solver solver(N, M);
+    Board presses(N, M);
+    int failures = 0;
+    for (int i = 0; i < 2000; i++) {
+        Board board = i % 2 ? generator.generate(N, M) : FixedBoard<N, M>(generator.next()).toBoard();
+        FixedBoard<N, M> fixedBoard = FixedBoard<N, M>::fromBoard(board);
+        if (fixedBoard.toBoard() != board) {
+            std::printf("FAILED: %dx%d board changes when converted to a FixedBoard and back\n", N, M);
+            return failures + 1;
+        }
+
+        uint64_t fixedPresses = 0;
+        bool solvable = FixedSolver<N, M>::solve(fixedBoard, fixedPresses);
+        if (solvable != solver.solve(board, presses)) {
+            std::printf("FAILED: FixedSolver and Solver disagree on whether a %dx%d board is solvable\n", N, M);
+            failures++;
+            continue;
+        }
+        if (!solvable)
+            continue;
+        for (int cell = 0; cell < N * M; cell++) {
+            if ((fixedPresses >> cell) & 1)
+                fixedBoard.press(cell / M, cell % M);
+        }
+        if (!fixedBoard.isSolved()) {
+            std::printf("FAILED: FixedSolver solution of a %dx%d board leaves lights on\n", N, M);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+template<int N>
+static void compare(Generator &generator) {
+    const int count = 100000;
+    std::vector<Board> boards;
+    std::vector<FixedBoard<N, N>> fixedBoards;
+    for (int i = 0; i < count; i++) {
+        boards.push_back(generator.generate(N, N));
+        fixedBoards.push_back(FixedBoard<N, N>::fromBoard(boards.back()));
+    }
+
+    Solver solver(N, N);
+    Board presses(N, N);
+    int solved = 0;
+    Clock::time_point start = Clock::now();
+    for (const Board &board : boards)
+        solved += solver.solve(board, presses);
+    double runtime = secondsSince(start);
+
+    // Fold the results into a checksum so the solves cannot be optimised away
+    uint64_t fixedPresses = 0, checksum = 0;
+    start = Clock::now();
+    for (const FixedBoard<N, N> &board : fixedBoards) {
+        solved += FixedSolver<N, N>::solve(board, fixedPresses);
+        checksum ^= fixedPresses;
+    }
+    double fixed = secondsSince(start);
+
+    std::printf("%dx%d %12.1f %12.1f %10.1fx   (%d solved, checksum %llx)\n", N, N, count / runtime / 1e6,
+                count / fixed / 1e6, runtime / fixed, solved, static_cast<unsigned long long>(checksum));
+}
+
+int main() {
+    Generator generator(2024);
+    std::printf("size   Solver (M/s)  Fixed (M/s)    speedup\n");
+    compare<4>(generator);
+    compare<5>(generator);
+    compare<6>(generator);
+    compare<7>(generator);
+
+    // Untimed checks, including a full 64-bit row
+    int failures = check<3, 3>(generator) + check<4, 4>(generator) + check<5, 5>(generator) + check<6, 6>(generator) +
+                   check<7, 7>(generator) + check<8, 8>(generator) + check<4, 9>(generator) + check<2, 32>(generator) +
+                   check<1, 64>(generator);
+    if (failures) {
+        std::printf("%d checks FAILED\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Benchmarks the GF(2) solver on square boards from 5x5 to 512x512, once per XOR kernel the CPU supports.
+// Setup is building and reducing the chase matrix (once per board size), solve is one Solver::solve() call.
+// Every solution is checked by pressing it on the board, on square, wide (solved transposed) and tall boards, and
+// the bench exits with an error if one leaves a light on.
+// Then times the minimum-press OptimalSolver on the sizes where enumerating every solution is practical. Its
+// solutions are checked too: the threaded search must find as few presses as the serial one, and on every board
+// size the game accepts with a distance table (3x3 up to 25 cells) the count must equal the table's breadth-first
+// distance, including after the table is saved and mapped back in.
+
+#include "../src/game/generator.h"
+#include "../src/game/optimalSolver.h"
+#include "../src/game/distanceTable.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @brief Returns true if pressing every cell set in presses turns every light of the board off.
+static bool clears(const Board &board, const Board &presses) {
+    Board lights = board;
+    for (int row = 0; row < board.getRows(); row++)
+        lights.pressRow(row, presses.getRow(row));
+    return lights.getLitCount() == 0;
+}
+
+int main() {
+    const int sizes[] = {5, 8, 16, 32, 64, 128, 256, 512};
+    // rows x cols, including wide boards (solved transposed) and sizes past one 64-bit word per row
+    const int checkedSizes[][2] = {{3, 3}, {4, 4}, {5, 5}, {5, 8}, {8, 5}, {3, 64}, {64, 3}, {7, 130}, {130, 7},
+                                   {65, 65}, {100, 257}, {257, 100}};
+    const gf2::Kernel kernels[] = {gf2::Kernel::Scalar, gf2::Kernel::SSE2, gf2::Kernel::AVX2};
+    Generator generator(12345);
+    int failures = 0;
+
+    std::printf("%-8s %-7s %8s %14s %14s\n", "kernel", "size", "nullity", "setup (ms)", "solve (ms)");
+    for (gf2::Kernel kernel : kernels) {
+        if (!gf2::setKernel(kernel))
+            continue;
+        for (int size : sizes) {
+            Clock::time_point start = Clock::now();
+            Solver solver(size, size);
+            double setup = secondsSince(start);
+
+            // Repeat small solves so the timer has something to measure
+            int repeats = size <= 32 ? 1000 : size <= 128 ? 50 : 5;
+            Board board = generator.generate(size, size), presses(size, size);
+            start = Clock::now();
+            for (int i = 0; i < repeats; i++)
+                solver.solve(board, presses);
+            double solve = secondsSince(start) / repeats;
+            if (!clears(board, presses)) {
+                std::printf("FAILED: %s solution of a %dx%d board leaves lights on\n", gf2::kernelName(kernel), size, size);
+                failures++;
+            }
+
+            std::printf("%-8s %3dx%-3d %8d %14.3f %14.4f\n", gf2::kernelName(kernel), size, size,
+                        solver.getNullity(), setup * 1e3, solve * 1e3);
+        }
+
+        // Check (untimed) boards of other shapes, several puzzles each
+        for (const auto &size : checkedSizes) {
+            Solver solver(size[0], size[1]);
+            Board presses(size[0], size[1]);
+            for (int i = 0; i < 10; i++) {
+                Board board = generator.generate(size[0], size[1]);
+                if (!solver.solve(board, presses) || !clears(board, presses)) {
+                    std::printf("FAILED: %s solution of a %dx%d board leaves lights on\n", gf2::kernelName(kernel),
+                                size[0], size[1]);
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Minimum-press solves (2^nullity solutions each)
+    const int optimalSizes[] = {4, 5, 9, 11, 16, 19, 32};
+    std::printf("\n%-7s %8s %8s %14s\n", "size", "nullity", "presses", "optimal (ms)");
+    for (int size : optimalSizes) {
+        OptimalSolver solver(size, size);
+        OptimalSolution solution, serial;
+        Board board = generator.generate(size, size);
+        // Four threads even on smaller machines, so the split search is always the one compared with the serial one
+        solver.solve(board, solution, 4);
+        std::printf("%3dx%-3d %8d %8d %14.3f\n", size, size, solver.getSolver().getNullity(),
+                    solution.pressCount, solution.seconds * 1e3);
+
+        solver.solve(board, serial, 1);
+        if (!clears(board, solution.presses) || solution.presses.getLitCount() != solution.pressCount ||
+            solution.pressCount != serial.pressCount) {
+            std::printf("FAILED: %dx%d optimal solution is invalid or differs from the serial search (%d vs %d)\n",
+                        size, size, solution.pressCount, serial.pressCount);
+            failures++;
+        }
+    }
+
+    // The minimum found by enumeration must match the breadth-first distance, on every size the game builds a table
+    // for (some, like 4x5, need more than 4 bits per distance)
+    std::printf("\n%-7s %8s\n", "table", "max");
+    for (int rows = 3; rows <= DistanceTable::MAX_CELLS / 3; rows++) {
+        for (int cols = 3; DistanceTable::supports(rows, cols); cols++) {
+            const std::string path = "distance_check.bin";
+            if (!DistanceTable::build(rows, cols).save(path)) {
+                std::printf("FAILED: could not save the %dx%d distance table\n", rows, cols);
+                failures++;
+                continue;
+            }
+            DistanceTable table = DistanceTable::open(path, rows, cols);
+            std::remove(path.c_str());
+            if (!table.isLoaded()) {
+                std::printf("FAILED: could not map the %dx%d distance table back in\n", rows, cols);
+                failures++;
+                continue;
+            }
+            std::printf("%3dx%-3d %8d\n", rows, cols, table.getMaxDistance());
+
+            OptimalSolver solver(rows, cols);
+            OptimalSolution solution;
+            for (int i = 0; i < 200; i++) {
+                Board board = generator.generate(rows, cols);
+                if (!solver.solve(board, solution) || !clears(board, solution.presses) ||
+                    solution.pressCount != table.distance(board)) {
+                    std::printf("FAILED: %dx%d optimal solution has %d presses, the distance table says %d\n",
+                                rows, cols, solution.pressCount, table.distance(board));
+                    failures++;
+                    break;
+                }
+                Board presses;
+                if (!table.solve(board, presses) || !clears(board, presses) ||
+                    presses.getLitCount() != solution.pressCount) {
+                    std::printf("FAILED: %dx%d distance table solution is invalid or not the shortest\n", rows, cols);
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (failures > 0) {
+        std::printf("\n%d check(s) FAILED\n", failures);
+        return 1;
+    }
+    return 0;
+}
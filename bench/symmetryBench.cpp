@@ -0,0 +1,60 @@
+// Benchmarks Symmetry::canonical() on every 5x5 board, and shows how much a SymmetryIndex of the solvable 5x5 boards
+// (keyed by canonical form, storing each board's distance) shrinks compared to one entry per board.
+
+#include "../src/game/distanceTable.h"
+#include "../src/game/symmetry.h"
+
+#include <chrono>
+#include <cstdio>
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @brief Converts a 5x5 state (bit 5 * row + col) into the packed 8x8 layout (bit 8 * row + col).
+static uint64_t toPacked(uint32_t state) {
+    uint64_t packed = 0;
+    for (int r = 0; r < 5; r++)
+        packed |= static_cast<uint64_t>((state >> (5 * r)) & 0x1F) << (8 * r);
+    return packed;
+}
+
+int main() {
+    const uint32_t states = uint32_t(1) << 25;
+
+    for (bool withComplement : {false, true}) {
+        Symmetry symmetry(5, withComplement);
+        Clock::time_point start = Clock::now();
+        uint64_t orbits = 0;
+        for (uint32_t state = 0; state < states; state++) {
+            uint64_t packed = toPacked(state);
+            orbits += symmetry.canonical(packed) == packed;
+        }
+        double seconds = secondsSince(start);
+        std::printf("%-14s %10.1f M canonicalisations/s, %u boards in %llu orbits (%.2fx smaller)\n",
+                    withComplement ? "D4 x compl." : "D4", states / seconds / 1e6, states,
+                    static_cast<unsigned long long>(orbits), static_cast<double>(states) / orbits);
+    }
+
+    // Distance is preserved by D4 (but not by complement), so a distance store can be keyed by D4 orbit
+    DistanceTable table = DistanceTable::build(5, 5);
+    Symmetry symmetry(5);
+    SymmetryIndex index(symmetry);
+    uint32_t solvable = 0;
+    Clock::time_point start = Clock::now();
+    for (uint32_t state = 0; state < states; state++) {
+        uint64_t packed = toPacked(state);
+        int distance = table.distance(state);
+        if (distance < 0 || symmetry.canonical(packed) != packed)
+            continue;
+        index.add(packed, static_cast<uint8_t>(distance));
+    }
+    index.finish();
+    for (uint32_t state = 0; state < states; state++)
+        solvable += table.distance(state) >= 0;
+    std::printf("SymmetryIndex: %u solvable boards stored as %zu entries (%.2fx smaller), built in %.2f s\n",
+                solvable, index.size(), static_cast<double>(solvable) / index.size(), secondsSince(start));
+    return 0;
+}
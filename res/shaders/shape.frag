@@ -1,10 +1,35 @@
 #version 330 core
 
+in vec2 localPos;
+flat in vec2 halfSize;
+flat in vec4 fillColor;
+flat in vec4 borderColor;
+flat in float borderWidth;
+flat in float radius;
+
 out vec4 FragColor;
 
-uniform vec4 shapeColor;
+// Signed distance from a rectangle with rounded corners, negative inside. A radius of 0 is a plain rectangle, and
+// a radius of half the side of a square is a circle.
+float roundedRect(vec2 p, vec2 halfExtent, float cornerRadius)
+{
+    vec2 q = abs(p) - halfExtent + cornerRadius;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - cornerRadius;
+}
 
 void main()
 {
-    FragColor = shapeColor;
-}
\ No newline at end of file
+    float dist = roundedRect(localPos, halfSize, radius);
+    float edge = fwidth(dist) * 0.5;
+
+    // Coverage of the fill, and of the border around it (zero when it has no width)
+    float inside = 1.0 - smoothstep(-edge, edge, dist);
+    float outline = (1.0 - smoothstep(-edge, edge, dist - borderWidth)) - inside;
+    float fill = fillColor.a * inside;
+    float border = borderColor.a * outline;
+
+    float alpha = fill + border;
+    if (alpha <= 0.0)
+        discard;
+    FragColor = vec4((fillColor.rgb * fill + borderColor.rgb * border) / alpha, alpha);
+}
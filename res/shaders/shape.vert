@@ -1,11 +1,39 @@
 #version 330 core
 
+// Unit quad corner, shared by every shape
 layout (location = 0) in vec2 aPos;
 
-uniform mat4 model;
-uniform mat4 projection;
+// Per shape: center, size, fill colour, border colour, and border width and corner radius (in pixels). Instanced
+// shapes read these from the instance buffer; single shapes set them as constant attributes.
+layout (location = 1) in vec2 aCenter;
+layout (location = 2) in vec2 aSize;
+layout (location = 3) in vec4 aFill;
+layout (location = 4) in vec4 aBorderColor;
+layout (location = 5) in vec2 aBorder;
+
+// Shared with every shader through a uniform buffer (binding point Shader::MATRICES_BINDING)
+layout (std140) uniform Matrices
+{
+    mat4 projection;
+};
+
+out vec2 localPos;
+flat out vec2 halfSize;
+flat out vec4 fillColor;
+flat out vec4 borderColor;
+flat out float borderWidth;
+flat out float radius;
 
 void main()
 {
-    gl_Position = projection * model * vec4(aPos.x, aPos.y, 0.0, 1.0);
-}
\ No newline at end of file
+    // Grow the quad past the shape by the border, plus a pixel for the antialiased edge
+    vec2 extent = aSize + 2.0 * (aBorder.x + 1.0);
+    localPos = aPos * extent;
+    gl_Position = projection * vec4(aCenter + localPos, 0.0, 1.0);
+
+    halfSize = aSize * 0.5;
+    fillColor = aFill;
+    borderColor = aBorderColor;
+    borderWidth = aBorder.x;
+    radius = min(aBorder.y, min(halfSize.x, halfSize.y));
+}
@@ -5,7 +5,11 @@ layout (location = 0) in vec4 vertex; // <vec2 position, vec2 texCoords>
 out vec2 TexCoords;
 
 uniform mat4 model;
-uniform mat4 projection;
+// Shared with every shader through a uniform buffer (binding point Shader::MATRICES_BINDING)
+layout (std140) uniform Matrices
+{
+    mat4 projection;
+};
 
 void main()
 {
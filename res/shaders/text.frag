@@ -1,12 +1,16 @@
 #version 330 core
 in vec2 TexCoords;
+in vec3 TextColor;
 out vec4 color;
 
+// Signed distance field atlas: 0.5 is the glyph's edge, higher is inside
 uniform sampler2D text;
-uniform vec3 textColor;
 
 void main()
 {    
-    vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-    color = vec4(textColor, 1.0) * sampled;
-}  
\ No newline at end of file
+    float distance = texture(text, TexCoords).r;
+    // Blend over about one screen pixel, however much the glyph is scaled
+    float smoothing = fwidth(distance) * 0.5;
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    color = vec4(TextColor, alpha);
+}
@@ -1,18 +1,66 @@
 #include "engine.h"
+#include "util/cache.h"
+#include "util/allocationCounter.h"
+#include "util/textBuffer.h"
+#include <algorithm>
 #include <ctime>
-#include <cstdlib>
+#include <chrono>
+#include <future>
+#include <thread>
 
 enum state {start, play, over};
 state screen;
 int moves = 0;
 
-Engine::Engine() : keys() {
+Engine::Engine(int rows, int cols, LatencyMode latency) : board(rows, cols), hints(rows, cols),
+        layout(GridLayout::fit(rows, cols, width, height)), hitTest(layout, rows, cols, width, height),
+        latency(latency) {
+    // Read files, build the font atlas and generate the puzzle on worker threads while the window and context come
+    // up. Only the OpenGL uploads happen on this thread, once the context exists.
+    auto shaderFiles = std::async(std::launch::async, [this] {
+        double begin = StartupProfile::now();
+        std::array<ShaderManager::ShaderFiles, 2> files = {
+                ShaderManager::readShaderFiles("shaders/shape.vert", "shaders/shape.frag"),
+                ShaderManager::readShaderFiles("shaders/text.vert", "shaders/text.frag")
+        };
+        startup.record("shaders", "worker", begin, StartupProfile::now());
+        return files;
+    });
+    auto fontAtlas = std::async(std::launch::async, [this] {
+        double begin = StartupProfile::now();
+        Font::Atlas atlas = Font::load("fonts/MxPlus_IBM_BIOS.ttf");
+        startup.record("font", "worker", begin, StartupProfile::now());
+        return atlas;
+    });
+    auto puzzle = std::async(std::launch::async, [this, rows, cols] {
+        double begin = StartupProfile::now();
+        Puzzle generated = generatePuzzle(rows, cols);
+        startup.record("puzzle", "worker", begin, StartupProfile::now());
+        return generated;
+    });
+
+    double begin = StartupProfile::now();
     this->initWindow();
-    this->initShaders();
-    this->initShapes();
+    startup.record("window", "main", begin, StartupProfile::now());
+
+    // get() waits for each worker, so these stages include any time spent waiting for them
+    begin = StartupProfile::now();
+    this->initShaders(shaderFiles.get(), fontAtlas.get());
+    startup.record("gl upload", "main", begin, StartupProfile::now());
+
+    begin = StartupProfile::now();
+    this->initShapes(puzzle.get());
+    this->initLabels();
+    startup.record("shapes", "main", begin, StartupProfile::now());
+
+    // A frame can handle at most a full queue of clicks
+    pendingClicks.reserve(InputQueue::CAPACITY);
 }
 
-Engine::~Engine() {}
+Engine::~Engine() {
+    if (frameFence != nullptr)
+        glDeleteSync(frameFence);
+}
 
 unsigned int Engine::initWindow(bool debug) {
     // glfw: initialize and configure
@@ -40,165 +88,366 @@ unsigned int Engine::initWindow(bool debug) {
     glViewport(0, 0, width, height);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glfwSwapInterval(1);
+
+    // Adaptive vsync needs the swap_control_tear extension; fall back to plain vsync without it
+    int swapInterval = latency.swapInterval;
+    if (swapInterval == LatencyMode::ADAPTIVE && !glfwExtensionSupported("WGL_EXT_swap_control_tear")
+            && !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+        cout << "ERROR::ENGINE: Adaptive vsync is not supported, using vsync" << endl;
+        swapInterval = 1;
+    }
+    glfwSwapInterval(swapInterval);
+
+    // Late input sampling needs to know when the next vblank is
+    const GLFWvidmode *mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    if (swapInterval != 0 && mode != nullptr && mode->refreshRate > 0)
+        refreshPeriod = 1.0 / mode->refreshRate;
+    lastSwap = glfwGetTime();
+
+    // Queue input events from GLFW callbacks instead of polling every key each frame
+    inputQueue.attach(window);
 
     return 0;
 }
 
-void Engine::initShaders() {
+void Engine::initShaders(const std::array<ShaderManager::ShaderFiles, 2> &shaderFiles, const Font::Atlas &fontAtlas) {
     // load shader manager
     shaderManager = make_unique<ShaderManager>();
 
-    // Load shader into shader manager and retrieve it
-    shapeShader = this->shaderManager->loadShader("../res/shaders/shape.vert", "../res/shaders/shape.frag",  nullptr, "shape");
+    // Load shader into shader manager and retrieve it (used by every shape, single or instanced)
+    shapeShader = this->shaderManager->loadShader(shaderFiles[0], "shape");
 
     // Configure text shader and renderer
-    textShader = shaderManager->loadShader("../res/shaders/text.vert", "../res/shaders/text.frag", nullptr, "text");
-    fontRenderer = make_unique<FontRenderer>(shaderManager->getShader("text"), "../res/fonts/MxPlus_IBM_BIOS.ttf", 24);
+    textShader = shaderManager->loadShader(shaderFiles[1], "text");
+    fontRenderer = make_unique<FontRenderer>(shaderManager->getShader("text"), fontAtlas, 24);
 
-    // Set uniforms
-    textShader.setVector2f("vertex", vec4(100, 100, .5, .5));
-    shapeShader.use();
-    shapeShader.setMatrix4("projection", this->PROJECTION);
+    // Set the projection once for every shader
+    matrices = make_unique<UniformBuffer>(Shader::MATRICES_BINDING, sizeof(mat4));
+    matrices->update(0, sizeof(mat4), glm::value_ptr(this->PROJECTION));
 }
 
-void Engine::initShapes() {
-    // Light foreground
-    const int SQUARE_SIDE = 100, GAP = 25, HOVER_BORDER_WIDTH = 10;
-    int yPos = height - SQUARE_SIDE;
-    for (int i = 0; i < 5; i++) {
-        int xPos = SQUARE_SIDE;
-        vector<unique_ptr<Shape>> row;
-        for (int j = 0; j < 5; j++) {
-            row.push_back(make_unique<Rect>(shapeShader, vec2{xPos, yPos}, vec2{SQUARE_SIDE, SQUARE_SIDE}, color{1, 1, 0, 1},1));
-            xPos += SQUARE_SIDE + GAP;
+Engine::Puzzle Engine::generatePuzzle(int rows, int cols) {
+    Puzzle puzzle;
+
+    // Puzzles are built from random presses, so they are always solvable
+    puzzle.board = generator.generate(rows, cols);
+
+    // Small boards look up par (the minimum number of presses) and the shortest solution for the hint overlay in the
+    // distance table. Larger boards solve once, with the fewest presses when that is practical.
+    if (DistanceTable::supports(rows, cols)) {
+        string tablePath = cachePath("distance_" + std::to_string(rows) + "x" + std::to_string(cols) + ".bin");
+        puzzle.distanceTable = make_unique<DistanceTable>(DistanceTable::open(tablePath, rows, cols));
+        if (!puzzle.distanceTable->isLoaded()) {
+            puzzle.distanceTable = make_unique<DistanceTable>(DistanceTable::build(rows, cols));
+            if (!puzzle.distanceTable->save(tablePath)) {
+                cout << "ERROR::ENGINE: Failed to save distance table to " << tablePath << endl;
+            }
+        }
+        puzzle.par = puzzle.distanceTable->distance(puzzle.board);
+        puzzle.distanceTable->solve(puzzle.board, puzzle.hints);
+    } else {
+        OptimalSolver optimalSolver(rows, cols, PAR_MAX_NULLITY);
+        if (optimalSolver.getSolver().getNullity() <= PAR_MAX_NULLITY) {
+            OptimalSolution solution;
+            optimalSolver.solve(puzzle.board, solution);
+            puzzle.hints = solution.presses;
+            if (solution.optimal)
+                puzzle.par = solution.pressCount;
+        } else {
+            // Too many solutions to find the fewest presses, so any solution will do for the hints
+            optimalSolver.getSolver().solve(puzzle.board, puzzle.hints);
         }
-        yPos -= SQUARE_SIDE + GAP;
-        // https://stackoverflow.com/questions/39724272/error-call-to-implicitly-deleted-copy-constructor-of-std-1unique-ptra-s
-        lights.push_back(std::move(row));
     }
+    return puzzle;
+}
 
-    // Hover
-    for (int i = 0; i < 5; i++) {
-        vector<unique_ptr<Shape>> row;
-        for (int j = 0; j < 5; j++) {
-            row.push_back(make_unique<Rect>(shapeShader, lights[i][j]->getPos(), vec2{SQUARE_SIDE + HOVER_BORDER_WIDTH, SQUARE_SIDE + HOVER_BORDER_WIDTH}, color (1, 0, 0, 0), 1));
+void Engine::initShapes(Puzzle puzzle) {
+    const int rows = board.getRows(), cols = board.getCols();
+
+    // One rounded light per cell, with its hover/hint border around it (transparent until needed)
+    const int cells = rows * cols;
+    const float HOVER_BORDER_WIDTH = layout.side / 20;
+    const float CORNER_RADIUS = layout.side / 8;
+    grid = make_unique<GridRenderer>(shapeShader, static_cast<size_t>(cells));
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            grid->setInstance(i * cols + j, layout.cellCenter(i, j), vec2{layout.side, layout.side}, color{1, 1, 0, 1},
+                              CORNER_RADIUS, HOVER_BORDER_WIDTH);
         }
-        // https://stackoverflow.com/questions/39724272/error-call-to-implicitly-deleted-copy-constructor-of-std-1unique-ptra-s
-        lights_hover.push_back(std::move(row));
     }
-    // https://www.geeksforgeeks.org/rand-and-srand-in-ccpp/#
-    srand(time(0));
-    int sum_cols;
-    int sum_rows;
-
-    // https://puzzling.stackexchange.com/questions/123075/how-do-i-determine-whether-a-5x5-lights-out-puzzle-is-solvable-without-trying-to
-    do {
-        sum_cols = 0;
-        sum_rows = 0;
-        for (int i = 0; i < 5; i++) {
-            for (int j = 0; j < 5; j++) {
-                // https://www.geeksforgeeks.org/rand-and-srand-in-ccpp/#
-                if (rand() % 2 == 0) {
-                    lights[i][j]->toggleStatus();
-                }
-            }
-        }
-        for (int i = 0; i < 5; i += 2) {
-            sum_rows += lights[i][0]->getStatus() + lights[i][1]->getStatus() + lights[i][3]->getStatus() + lights[i][4]->getStatus();
-        }
+    board = std::move(puzzle.board);
+    hints = std::move(puzzle.hints);
+    par = puzzle.par;
+    distanceTable = std::move(puzzle.distanceTable);
+}
 
-        for (int i = 0; i < 5; i += 2) {
-            sum_cols += lights[0][i]->getStatus() + lights[1][i]->getStatus() + lights[3][i]->getStatus() + lights[4][i]->getStatus();
-        }
-    } while (sum_rows % 2 == 1 || sum_cols % 2 == 1);
+void Engine::initLabels() {
+    const string_view message = "Press s to start";
+    const string_view description[] = {
+            "Click all of the yellow lights until they",
+            "all turn gray! Be careful, the surrounding",
+            "lights turn on or off depending on ",
+            "their state when you click!",
+            "Press h while playing to show hints."
+    };
+    // Lines below the title; the hint line is set apart from the rules
+    const float offsets[] = {30, 50, 70, 90, 120};
+
+    // (12 * message.length()) is the offset to center text.
+    // 12 pixels is the width of each character scaled by 1.
+    const float left = width / 2.0f - 12 * message.length();
+    startLabels[0] = TextLabel(message, left, height / 2, 1, vec3{0, .9, 0});
+    for (int i = 0; i < 5; i++) {
+        startLabels[i + 1] = TextLabel(description[i], left, height / 2 - offsets[i], .5, vec3{1, 1, 1});
+    }
 
+    // Labels whose text changes get room for the longest text a TextBuffer can hold, so updating them never allocates
+    movesLabel = TextLabel("", 25, 15, 0.6, vec3 {1, 1, 1});
+    movesLabel.reserve(TextBuffer::CAPACITY);
+    updateMovesLabel();
+
+    // Difficulty by par relative to board size (on 5x5: up to 5 presses is easy, up to 10 is medium)
+    int cells = board.getCellCount();
+    string_view difficulty = par < 0 ? "" : par * 5 <= cells ? "Easy" : par * 5 <= 2 * cells ? "Medium" : "Hard";
+    difficultyLabel = TextLabel(difficulty, width / 2 + 25, 15, 0.6, vec3 {1, 1, 1});
+
+    const string_view win = "You win!";
+    const float overLeft = width / 2.0f - 12 * win.length();
+    overLabels[0] = TextLabel(win, overLeft, height / 2, 1, vec3 {1, 1, 1});
+    overLabels[1] = TextLabel("", overLeft, height / 2 - 30, .6, vec3 {1, 1, 1});
+    overLabels[2] = TextLabel("", overLeft, height / 2 - 60, .6, vec3 {1, 1, 1});
+    overLabels[1].reserve(TextBuffer::CAPACITY);
+    overLabels[2].reserve(TextBuffer::CAPACITY);
+
+    // The start screen queues the most text; leave room for every screen's labels at their longest
+    size_t glyphs = 0;
+    for (const TextLabel &label : startLabels)
+        glyphs += label.getText().size();
+    fontRenderer->reserve(std::max(glyphs, 3 * TextBuffer::CAPACITY));
 }
 
-void Engine::processInput() {
-    glfwPollEvents();
-
-    // Set keys to true if pressed, false if released
-    for (int key = 0; key < 1024; ++key) {
-        if (glfwGetKey(window, key) == GLFW_PRESS)
-            keys[key] = true;
-        else if (glfwGetKey(window, key) == GLFW_RELEASE)
-            keys[key] = false;
+void Engine::updateMovesLabel() {
+    TextBuffer text;
+    text << "Moves: " << moves;
+    movesLabel.setText(text.view());
+}
+
+void Engine::updateOverLabels() {
+    TextBuffer text;
+    text << "You finished in " << timer << " seconds";
+    overLabels[1].setText(text.view());
+
+    text.clear();
+    text << "with " << moves << " clicks!";
+    if (par >= 0) {
+        text << " (par " << par << ")";
     }
+    overLabels[2].setText(text.view());
+}
 
-    // Close window if escape key is pressed
-    if (keys[GLFW_KEY_ESCAPE])
-        glfwSetWindowShouldClose(window, true);
+void Engine::beginFrame() {
+    frameAllocations = allocationCount();
+    // Keep at most one frame queued on the GPU
+    if (frameFence != nullptr) {
+        glClientWaitSync(frameFence, GL_SYNC_FLUSH_COMMANDS_BIT, 100'000'000); // 100 ms timeout
+        glDeleteSync(frameFence);
+        frameFence = nullptr;
+    }
 
-    // Mouse position saved to check for collisions
-    glfwGetCursorPos(window, &MouseX, &MouseY);
+    // Sleep through the part of the frame the input would otherwise wait in, leaving twice the usual build time
+    // (plus a millisecond for the scheduler) before the vblank
+    if (latency.lateInput && refreshPeriod > 0) {
+        double wake = lastSwap + refreshPeriod - 2 * frameBuildTime - 0.001;
+        double now = glfwGetTime();
+        if (wake > now)
+            std::this_thread::sleep_for(std::chrono::duration<double>(wake - now));
+    }
+}
 
-    // If we're in the start screen and the user presses s, change screen to play
-    if (keys[GLFW_KEY_S] && screen == start) {
-        screen = play;
-        time_t curr_time;
-        time(&curr_time);
-        timer = (unsigned long)curr_time;
+void Engine::printReport() const {
+    clickToPhoton.print("Click-to-photon");
+    cout << "Frames drawn: " << renderedFrames << ", skipped: " << skippedFrames << endl;
+    if (countingAllocations()) {
+        cout << "Frames that allocated: " << allocatingFrames << " of " << (renderedFrames > 0 ? renderedFrames - 1 : 0)
+             << " (after the first)" << endl;
     }
+}
 
-    // Mouse position is inverted because the origin of the window is in the top left corner
-    MouseY = height - MouseY; // Invert y-axis of mouse position
-    bool mousePressed = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+size_t Engine::getAllocatingFrames() const {
+    return allocatingFrames;
+}
 
-    if (screen == play) {
-        // Checking for hover
-        for (int i = 0; i < 5; i++) {
-            for (int j = 0; j < 5; j++) {
-
-                if (lights[i][j]->getStatus() == 1) {
-                    lights[i][j]->setColor(color {1, 1, 0, 1});
-                } else {
-                    lights[i][j]->setColor(color {0.5, 0.5, 0.5, 1});
+void Engine::setAutoplay(bool autoplay) {
+    autoplaying = autoplay;
+}
+
+void Engine::queueAutoplayInput() {
+    if (!inputQueue.isEmpty())
+        return;
+    if (screen == start) {
+        inputQueue.push(InputEvent{InputEvent::Key, GLFW_KEY_S, GLFW_PRESS, 0, 0, glfwGetTime()});
+        return;
+    }
+    if (screen == over) {
+        // Close once the game over screen has been drawn
+        if (!dirty)
+            glfwSetWindowShouldClose(window, true);
+        return;
+    }
+
+    // Click the first light an even number of times (changing nothing), then every light in the hints
+    const int cols = board.getCols();
+    int cell = 0;
+    if (autoplayClicks >= AUTOPLAY_EXTRA_CLICKS) {
+        while (cell < board.getCellCount() && !hints.isLit(cell / cols, cell % cols))
+            cell++;
+        if (cell == board.getCellCount())
+            return;
+    }
+    autoplayClicks++;
+    vec2 center = layout.cellCenter(cell / cols, cell % cols);
+    inputQueue.push(InputEvent{InputEvent::MouseButton, GLFW_MOUSE_BUTTON_LEFT, GLFW_RELEASE, center.x,
+                               height - center.y, glfwGetTime()});
+}
+
+void Engine::processInput() {
+    // Nothing to redraw, so sleep until there is input to handle
+    if (dirty || latency.continuous || autoplaying)
+        glfwPollEvents();
+    else
+        glfwWaitEventsTimeout(IDLE_TIMEOUT);
+    frameStart = glfwGetTime();
+
+    if (autoplaying)
+        queueAutoplayInput();
+
+    // Only redo every light's colour when something changed all of them
+    bool changed = false;
+
+    InputEvent event;
+    while (inputQueue.pop(event)) {
+        switch (event.type) {
+            case InputEvent::Key: {
+                if (event.action != GLFW_PRESS)
+                    break;
+
+                // Close window if escape key is pressed
+                if (event.code == GLFW_KEY_ESCAPE)
+                    glfwSetWindowShouldClose(window, true);
+
+                // If we're in the start screen and the user presses s, change screen to play
+                if (event.code == GLFW_KEY_S && screen == start) {
+                    screen = play;
+                    time_t curr_time;
+                    time(&curr_time);
+                    timer = (unsigned long)curr_time;
+                    changed = true;
+                    dirty = true;
                 }
 
-                // if clicked
-                if (lights[i][j]->isOverlapping(vec2{MouseX, MouseY})) {
-                    lights_hover[i][j]->setOpacity(1);
-                    if (mousePressedLastFrame && !mousePressed) {
-                        moves++;
-                        lights[i][j]->toggleStatus();
-                        if (j + 1 < 5) {
-                            lights[i][j+1]->toggleStatus();
-                        }
-                        if (j - 1 >= 0) {
-                            lights[i][j-1]->toggleStatus();
-                        }
-                        if (i + 1 < 5) {
-                            lights[i+1][j]->toggleStatus();
-                        }
-                        if (i - 1 >= 0) {
-                            lights[i-1][j]->toggleStatus();
-                        }
-                    }
-                } else {
-                    lights_hover[i][j]->setOpacity(0);
+                // Toggle the hint overlay when h is pressed
+                if (event.code == GLFW_KEY_H) {
+                    showHints = !showHints;
+                    changed = true;
                 }
+                break;
             }
-        }
-        bool done = true;
-        for (int i = 0; i < 5; i++) {
-            for (int j = 0; j < 5; j++) {
-                if (lights[i][j]->getStatus() != 0) {
-                    done = false;
-                }
+            case InputEvent::CursorPos: {
+                // Mouse position is inverted because the origin of the window is in the top left corner
+                MouseX = event.x;
+                MouseY = height - event.y;
+                if (screen == play)
+                    updateHover(vec2{MouseX, MouseY});
+                break;
+            }
+            case InputEvent::MouseButton: {
+                // A click is the release of the left button over a light
+                if (event.code != GLFW_MOUSE_BUTTON_LEFT || event.action != GLFW_RELEASE || screen != play)
+                    break;
+                int cell = hitTest.cellAt(vec2{event.x, height - event.y});
+                if (cell < 0)
+                    break;
+                int row = cell / board.getCols(), col = cell % board.getCols();
+                moves++;
+                board.press(row, col);
+                hints.toggle(row, col);
+                updatePressed(row, col);
+                updateMovesLabel();
+                pendingClicks.push_back(event.time);
+                dirty = true; // The move counter changed too
+                break;
             }
+            case InputEvent::Refresh: {
+                // The window was exposed or restored, and its contents may be gone
+                dirty = true;
+                break;
+            }
+        }
+    }
+
+    if (screen == play) {
+        if (changed) {
+            hoveredCell = hitTest.cellAt(vec2{MouseX, MouseY});
+            updateGrid();
         }
-        if (done) {
+        if (board.isSolved()) {
             time_t end_time;
             time(&end_time);
             timer = (unsigned long)end_time - timer;
             screen = over;
+            updateOverLabels();
+            dirty = true;
         }
     }
+}
 
-    // Save mousePressed for next frame
-    mousePressedLastFrame = mousePressed;
+void Engine::updateGrid() {
+    for (int i = 0; i < board.getRows(); i++) {
+        for (int j = 0; j < board.getCols(); j++) {
+            updateCell(i, j);
+        }
+    }
+}
 
+void Engine::updateCell(int row, int col) {
+    dirty = true;
+    const int cell = row * board.getCols() + col;
+    if (board.isLit(row, col)) {
+        grid->setColor(cell, color {1, 1, 0, 1});
+    } else {
+        grid->setColor(cell, color {0.5, 0.5, 0.5, 1});
+    }
+
+    if (cell == hoveredCell) {
+        grid->setBorderColor(cell, color {1, 0, 0, 1});
+    } else if (showHints && hints.isLit(row, col)) {
+        // Outline the lights still to press in green
+        grid->setBorderColor(cell, color {0, 1, 0, 1});
+    } else {
+        grid->setBorderColor(cell, color {1, 0, 0, 0});
+    }
+}
+
+void Engine::updatePressed(int row, int col) {
+    updateCell(row, col);
+    if (row > 0) updateCell(row - 1, col);
+    if (row < board.getRows() - 1) updateCell(row + 1, col);
+    if (col > 0) updateCell(row, col - 1);
+    if (col < board.getCols() - 1) updateCell(row, col + 1);
+}
+
+void Engine::updateHover(vec2 point) {
+    int cell = hitTest.cellAt(point);
+    if (cell == hoveredCell)
+        return;
+
+    int previous = hoveredCell;
+    hoveredCell = cell;
+    const int cols = board.getCols();
+    if (previous >= 0)
+        updateCell(previous / cols, previous % cols);
+    if (cell >= 0)
+        updateCell(cell / cols, cell % cols);
 }
 
 void Engine::update() {
@@ -209,6 +458,14 @@ void Engine::update() {
 }
 
 void Engine::render() {
+    // The last frame is still correct, so leave it on screen
+    if (!dirty && !latency.continuous) {
+        skippedFrames++;
+        return;
+    }
+    dirty = false;
+    renderedFrames++;
+
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Set background color
     glClear(GL_COLOR_BUFFER_BIT);
 
@@ -217,54 +474,48 @@ void Engine::render() {
 
     switch (screen) {
         case (start): {
-            string message = "Press s to start",
-                    game_desc1 = "Click all of the yellow lights until they",
-                    game_desc2 = "all turn gray! Be careful, the surrounding",
-                    game_desc3 = "lights turn on or off depending on ",
-                    game_desc4 = "their state when you click!";
-
-            // (12 * message.length()) is the offset to center text.
-            // 12 pixels is the width of each character scaled by 1.
-            this->fontRenderer->renderText(message, width / 2 - (12 * message.length()), height / 2, 1, vec3{0, .9, 0});
-            this->fontRenderer->renderText(game_desc1, width / 2 - (12 * message.length()), height / 2 - 30, .5, vec3{1, 1, 1});
-            this->fontRenderer->renderText(game_desc2, width / 2 - (12 * message.length()), height / 2 - 30 - 20, .5, vec3{1, 1, 1});
-            this->fontRenderer->renderText(game_desc3, width / 2 - (12 * message.length()), height / 2 - 30 - 40, .5, vec3{1, 1, 1});
-            this->fontRenderer->renderText(game_desc4, width / 2 - (12 * message.length()), height / 2 - 30 - 60, .5, vec3{1, 1, 1});
-
+            for (TextLabel &label : startLabels)
+                label.draw(*fontRenderer);
             break;
         }
         case (play): {
-            string message = "Moves: " + std::to_string(moves);
-            // draw red outline
-            for (vector<unique_ptr<Shape>> &row: lights_hover) {
-                for (unique_ptr<Shape> &square: row) {
-                    square->setUniforms();
-                    square->draw();
-                }
-            }
-            // draw yellow square
-            for (vector<unique_ptr<Shape>> &row: lights) {
-                for (unique_ptr<Shape> &square: row) {
-                    square->setUniforms();
-                    square->draw();
-                }
-            }
-            this->fontRenderer->renderText(message, 25, 15, 0.6, vec3 {1, 1, 1});
+            // draw the lights and their outlines in one call
+            grid->draw();
+            movesLabel.draw(*fontRenderer);
+            difficultyLabel.draw(*fontRenderer);
             break;
         }
         case (over): {
-            string message = "You win!";
-            string final_time = "You finished in " + std::to_string(timer) + " seconds";
-            string final_clicks = "with " + std::to_string(moves) + " clicks!";
-            fontRenderer->renderText(message, width / 2 - (12 * message.length()), height / 2, 1, vec3 {1, 1, 1});
-            fontRenderer->renderText(final_time, width / 2 - (12 * message.length()), height / 2 - 30, .6, vec3 {1, 1, 1});
-            fontRenderer->renderText(final_clicks, width / 2 - (12 * message.length()), height / 2 - 60, .6, vec3 {1, 1, 1});
-
+            for (TextLabel &label : overLabels)
+                label.draw(*fontRenderer);
             break;
         }
     }
 
+    // Draw all the text queued this frame in one call
+    fontRenderer->flush();
+
+    double built = glfwGetTime();
+    frameBuildTime = 0.9 * frameBuildTime + 0.1 * (built - frameStart);
+
     glfwSwapBuffers(window);
+    if (latency.gpuSync == LatencyMode::GpuSync::Finish)
+        glFinish();
+    else if (latency.gpuSync == LatencyMode::GpuSync::Fence)
+        frameFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    lastSwap = glfwGetTime();
+
+    // The clicks handled this frame are on screen once the swap has gone through
+    for (double clicked : pendingClicks)
+        clickToPhoton.add(lastSwap - clicked);
+    pendingClicks.clear();
+
+    if (renderedFrames == 1)
+        startup.print(StartupProfile::now());
+
+    // The first frame lays out its labels and sizes the buffers; after that, frames should not allocate
+    if (renderedFrames > 1 && allocationCount() != frameAllocations)
+        allocatingFrames++;
 }
 
 bool Engine::shouldClose() {
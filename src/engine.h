@@ -1,6 +1,7 @@
 #ifndef GRAPHICS_ENGINE_H
 #define GRAPHICS_ENGINE_H
 
+#include <array>
 #include <ctime>
 #include <vector>
 #include <memory>
@@ -8,11 +9,25 @@
 #include <GLFW/glfw3.h>
 
 #include "shader/shaderManager.h"
+#include "shader/uniformBuffer.h"
 #include "font/fontRenderer.h"
+#include "font/textLabel.h"
 #include "shapes/rect.h"
+#include "shapes/circle.h"
 #include "shapes/shape.h"
+#include "shapes/gridRenderer.h"
+#include "game/board.h"
+#include "game/generator.h"
+#include "game/optimalSolver.h"
+#include "game/distanceTable.h"
+#include "util/gridLayout.h"
+#include "input/inputQueue.h"
+#include "input/hitTest.h"
+#include "util/startupProfile.h"
+#include "util/latencyMode.h"
+#include "util/latencyStats.h"
 
-using std::vector, std::unique_ptr, std::make_unique, glm::ortho, glm::mat4, glm::vec3, glm::vec4;
+using std::vector, std::string_view, std::unique_ptr, std::make_unique, glm::ortho, glm::mat4, glm::vec3, glm::vec4;
 
 /**
  * @brief The Engine class.
@@ -26,9 +41,8 @@ private:
     /// @brief The width and height of the window.
     const unsigned int width = 700, height = 700; // Window dimensions
 
-    /// @brief Keyboard state (True if pressed, false if not pressed).
-    /// @details Index this array with GLFW_KEY_{key} to get the state of a key.
-    bool keys[1024];
+    /// @brief Key, mouse button and cursor events queued by the GLFW callbacks, drained in processInput().
+    InputQueue inputQueue;
 
     /// @brief Responsible for loading and storing all the shaders used in the project.
     /// @details Initialized in initShaders()
@@ -38,58 +52,207 @@ private:
     /// @details Initialized in initShaders()
     unique_ptr<FontRenderer> fontRenderer;
 
-    // Shapes
-    vector<vector<unique_ptr<Shape>>> lights;
-    vector<vector<unique_ptr<Shape>>> lights_hover;
+    /// @brief The game state. The light shapes only read from it for display.
+    Board board;
 
+    /// @brief Generates the puzzle. Seeded once, when the engine is created.
+    Generator generator;
+
+    /// @brief Optimal distance to solved for every state of small boards (e.g. 5x5), or null for larger boards.
+    /// @details Memory-mapped from the cache directory, and built and saved there on the first launch.
+    unique_ptr<DistanceTable> distanceTable;
+
+    /// @brief The presses that solve the current board. Solved once per puzzle, then kept up to date with one
+    /// toggle per move (pressing cell k changes the solution by exactly cell k).
+    Board hints;
+
+    /// @brief Whether the hint overlay is shown (toggled with h).
+    bool showHints = false;
+
+    /// @brief The fewest presses that solve the puzzle, or -1 if it was not worked out.
+    int par = -1;
+
+    /// @brief Par is only worked out when there are at most 2^PAR_MAX_NULLITY solutions to compare.
+    static constexpr int PAR_MAX_NULLITY = 16;
+
+    /// @brief Pixel layout of the light grid, computed from the board size and window size.
+    GridLayout layout;
+
+    /// @brief Maps the cursor to the light under it in constant time, instead of testing every light.
+    HitTest hitTest;
+
+    /// @brief The light under the cursor (row * cols + col), or -1 if there is none.
+    int hoveredCell = -1;
+
+    /// @brief Draws the light grid in one instanced call.
+    /// @details One instance per light, indexed row * cols + col. The hover/hint outline is the light's own border,
+    /// drawn by the same instance.
+    unique_ptr<GridRenderer> grid;
+
+    /// @brief The shared "Matrices" uniform block (the projection), used by every shader.
+    unique_ptr<UniformBuffer> matrices;
 
     // Shaders
     Shader shapeShader;
     Shader textShader;
 
-    double MouseX, MouseY;
-    bool mousePressedLastFrame = false;
+    double MouseX = 0, MouseY = 0;
+
+    /// @brief Swap interval, input sampling and GPU queueing settings, from the command line.
+    LatencyMode latency;
+
+    /// @brief Seconds between vblanks at the current swap interval, or 0 if unknown (or vsync is off).
+    double refreshPeriod = 0;
+
+    /// @brief glfwGetTime() when the last swap (and GPU sync, if any) returned, and when this frame started building.
+    double lastSwap = 0, frameStart = 0;
+
+    /// @brief Smoothed time to build a frame (from sampling input to the swap), so late input knows when to wake.
+    double frameBuildTime = 0.002;
+
+    /// @brief Fence after the last swap, waited on before the next frame with LatencyMode::GpuSync::Fence.
+    GLsync frameFence = nullptr;
+
+    /// @brief Whether something on screen changed since the last swap. Frames are only drawn when it is set,
+    /// unless LatencyMode::continuous is on.
+    bool dirty = true;
+
+    /// @brief Frames drawn and swapped, and frames skipped because nothing changed.
+    size_t renderedFrames = 0, skippedFrames = 0;
+
+    /// @brief Longest the loop blocks waiting for events while nothing is dirty, in seconds.
+    static constexpr double IDLE_TIMEOUT = 0.5;
+
+    /// @brief Frames that made heap allocations, out of those drawn since the first (counted only when built with
+    /// LIGHTS_OUT_COUNT_ALLOCATIONS), and the allocation count when the current frame started.
+    size_t allocatingFrames = 0, frameAllocations = 0;
+
+    /// @brief The text of each screen, laid out once and updated only when it changes (e.g. the move counter).
+    TextLabel startLabels[6];
+    TextLabel movesLabel, difficultyLabel;
+    TextLabel overLabels[3];
+
+    /// @brief When each startup stage ran, reported with the time to the first frame.
+    StartupProfile startup;
+
+    /// @brief A generated puzzle with its solution and par, prepared on a worker thread during startup.
+    struct Puzzle {
+        Board board, hints;
+        int par = -1;
+        unique_ptr<DistanceTable> distanceTable;
+    };
+
+    /// @brief Generates a puzzle, solves it for the hints, and works out par.
+    /// @details Makes no OpenGL calls, so it runs on a worker thread while the window is created.
+    Puzzle generatePuzzle(int rows, int cols);
+
+    /// @brief Event times of the clicks handled since the last swap, and their click-to-photon latencies.
+    /// @details Reserved for a full input queue of clicks, so recording them never allocates.
+    vector<double> pendingClicks;
+    LatencyStats clickToPhoton;
 
     // Timer
     unsigned long timer;
 
+    /// @brief Whether the game plays itself (see setAutoplay()), and the clicks it has made so far.
+    bool autoplaying = false;
+    int autoplayClicks = 0;
+
+    /// @brief Wasted clicks autoplay makes before solving, enough to take the move counter to two digits.
+    static constexpr int AUTOPLAY_EXTRA_CLICKS = 12;
+
+    /// @brief Queues the next scripted input when autoplaying: one key press or click per frame.
+    void queueAutoplayInput();
+
     /// @note Call glCheckError() after every OpenGL call to check for errors.
     GLenum glCheckError_(const char *file, int line);
     /// @brief Macro for glCheckError_ function. Used for debugging.
 #define glCheckError() glCheckError_(__FILE__, __LINE__)
 
 public:
+    /// @brief The largest number of rows or columns the game plays on.
+    /// @details Past this, cells are under a pixel wide and generating the puzzle delays the first frame.
+    static constexpr int MAX_BOARD_SIZE = 1024;
+
     /// @brief Constructor for the Engine class.
     /// @details Initializes window and shaders.
-    Engine();
+    /// @param rows The number of rows of lights
+    /// @param cols The number of columns of lights
+    /// @param latency Swap interval, input sampling and GPU queueing settings
+    Engine(int rows = 5, int cols = 5, LatencyMode latency = LatencyMode());
 
-    /// @brief Destructor for the Engine class.
+    /// @brief Deletes the frame fence. Like the engine's other GL objects, it needs the context, so destroy the
+    /// engine before calling glfwTerminate().
     ~Engine();
 
     /// @brief Initializes the GLFW window.
     /// @return 0 if successful, -1 otherwise.
     unsigned int initWindow(bool debug = false);
 
-    /// @brief Loads shaders from files and stores them in the shaderManager.
-    /// @details Renderers are initialized here.
-    void initShaders();
+    /// @brief Creates the shader programs and stores them in the shaderManager.
+    /// @details Renderers are initialized here. The files are read, and the font atlas built, on worker threads
+    /// beforehand; only the OpenGL uploads happen here.
+    /// @param shaderFiles The shape and text shaders' sources
+    /// @param fontAtlas The font's glyph atlas
+    void initShaders(const std::array<ShaderManager::ShaderFiles, 2> &shaderFiles, const Font::Atlas &fontAtlas);
+
+    /// @brief Initializes the shapes to be rendered, and takes over the puzzle generated during startup.
+    void initShapes(Puzzle puzzle);
+
+    /// @brief Initializes the text labels of every screen.
+    /// @details Called after initShapes(), once par is known.
+    void initLabels();
 
-    /// @brief Initializes the shapes to be rendered.
-    void initShapes();
+    /// @brief Updates the move counter label from moves.
+    void updateMovesLabel();
+
+    /// @brief Fills in the game over labels (time, clicks and par).
+    void updateOverLabels();
 
     /// @brief Pushes back a new colored rectangle to the confetti vector.
     void spawnConfetti();
 
+    /// @brief Waits until it is time to sample input for the next frame.
+    /// @details Waits for the previous frame's fence with GpuSync::Fence. With late input, also sleeps until just
+    /// before the next vblank minus the time a frame takes to build, so input is as fresh as possible when shown.
+    void beginFrame();
+
+    /// @brief Prints the click-to-photon latency percentiles (from a click event to the swap showing it), the
+    /// number of frames drawn and skipped, and how many frames allocated (when counting allocations).
+    void printReport() const;
+
+    /// @brief Frames after the first that made heap allocations on the render thread (0 unless counting them).
+    size_t getAllocatingFrames() const;
+
+    /// @brief Plays a scripted session: starts the game, clicks past ten moves, solves the puzzle from the hints,
+    /// shows the game over screen and closes the window.
+    /// @details With LIGHTS_OUT_COUNT_ALLOCATIONS this checks that no frame of a whole session allocates.
+    void setAutoplay(bool autoplay);
+
     /// @brief Processes input from the user.
-    /// @details (e.g. keyboard input, mouse input, etc.)
+    /// @details Drains the input queue and acts only on the events in it (e.g. key presses, clicks, cursor moves).
+    /// When nothing is dirty, blocks until an event arrives (or IDLE_TIMEOUT passes) instead of spinning.
     void processInput();
 
+    /// @brief Colours every light from the board, and outlines the hovered light and the hints.
+    /// @details Only needed when every light may have changed (e.g. showing the hints). Moves use updateCell().
+    void updateGrid();
+
+    /// @brief Colours one light from the board, and outlines it if it is hovered or a hint.
+    void updateCell(int row, int col);
+
+    /// @brief Updates the lights a press at (row, col) changed: the light itself and its neighbours.
+    void updatePressed(int row, int col);
+
+    /// @brief Moves the hover outline to the light under the point, updating only the old and new lights.
+    void updateHover(vec2 point);
+
     /// @brief Updates the game state.
     /// @details (e.g. collision detection, delta time, etc.)
     void update();
 
     /// @brief Renders the game state.
-    /// @details Displays/renders objects on the screen.
+    /// @details Displays/renders objects on the screen. Skipped when nothing is dirty.
     void render();
 
     /* deltaTime variables */
@@ -107,7 +270,8 @@ public:
     bool shouldClose();
 
     /// Projection matrix used for 2D rendering (orthographic projection).
-    /// We don't have to change this matrix since the screen size never changes.
+    /// We don't have to change this matrix since the screen size never changes, so it is uploaded once to the
+    /// shared "Matrices" uniform buffer for every shader (shapes, grid and text).
     /// OpenGL uses the projection matrix to map the 3D scene to a 2D viewport.
     /// The projection matrix transforms coordinates in the camera space into normalized device coordinates (view space to clip space).
     /// @note The projection matrix is used in the vertex shader.
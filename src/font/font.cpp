@@ -1,77 +1,211 @@
 #include "font.h"
+#include "../util/cache.h"
+#include "../util/hash.h"
+#include "../util/resourcePack.h"
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
-Font::Font(std::string fontPath, unsigned int fontSize) {
+/// @brief Header of a cached atlas file, followed by the Characters array and then the atlas pixels.
+struct FontCacheHeader {
+    char magic[4];
+    uint32_t characterSize;   // sizeof(Character), so caches from a different build are rejected
+    uint64_t fontHash;        // FNV-1a of the font file
+    uint32_t pixelSize;
+    int32_t width, height;
+};
+
+static const char FONT_CACHE_MAGIC[4] = {'L', 'O', 'F', '1'};
+
+const unsigned char *Font::Atlas::pixels() const {
+    if (cache.isOpen())
+        return cache.data() + sizeof(FontCacheHeader) + sizeof(characters);
+    return rendered.data();
+}
+
+Font::Atlas Font::load(const std::string &fontPath, unsigned int fontSize) {
+    Atlas atlas;
+    atlas.pixelSize = fontSize;
+
+    // Hash the font file, so a changed font never loads a stale atlas
+    Resource fontFile = ResourcePack::open(fontPath);
+    if (!fontFile.isOpen()) {
+        std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        return atlas;
+    }
+    uint64_t fontHash = fnv1a64(fontFile.data(), fontFile.size());
+
+    std::string cache = cacheFile(fontPath, fontSize);
+    if (loadCache(cache, fontHash, atlas))
+        return atlas;
+
     FT_Library ft;
 
     // Initialize FreeType library
     if (FT_Init_FreeType(&ft)) {
         std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+        return atlas;
     }
 
-    // Load font as face
+    // Load font as face, straight from the resource pack
     FT_Face face;
-    if (FT_New_Face(ft, fontPath.c_str(), 0, &face)) {
+    if (FT_New_Memory_Face(ft, fontFile.data(), static_cast<FT_Long>(fontFile.size()), 0, &face)) {
         std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        FT_Done_FreeType(ft);
+        return atlas;
     }
 
     // Set size to load glyphs as
     FT_Set_Pixel_Sizes(face, 0, fontSize);
 
-    // Attempt to load character glyph
-    if (FT_Load_Char(face, 'X', FT_LOAD_RENDER)) {
-        std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
+    rasterize(face, atlas);
+    saveCache(cache, fontHash, atlas);
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    return atlas;
+}
+
+Font::Font(std::string fontPath, unsigned int fontSize) : Font(load(fontPath, fontSize)) {}
+
+Font::Font(const Atlas &atlas) : Characters(atlas.characters), AtlasSize(atlas.size), PixelSize(atlas.pixelSize) {
+    if (AtlasSize.y > 0)
+        upload(atlas.pixels());
+}
+
+std::string Font::cacheFile(const std::string &fontPath, unsigned int fontSize) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "font_%016llx_%u.bin",
+                  static_cast<unsigned long long>(fnv1a64(fontPath)), fontSize);
+    return cachePath(name);
+}
+
+bool Font::loadCache(const std::string &path, uint64_t fontHash, Atlas &atlas) {
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(FontCacheHeader))
+        return false;
+
+    FontCacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, FONT_CACHE_MAGIC, sizeof(FONT_CACHE_MAGIC)) != 0 ||
+        header.characterSize != sizeof(Character) || header.fontHash != fontHash ||
+        header.pixelSize != atlas.pixelSize || header.width != ATLAS_WIDTH || header.height < 0)
+        return false;
+    size_t expected = sizeof(FontCacheHeader) + sizeof(atlas.characters) + static_cast<size_t>(header.width) * header.height;
+    if (file.size() != expected)
+        return false;
+
+    std::memcpy(atlas.characters.data(), file.data() + sizeof(FontCacheHeader), sizeof(atlas.characters));
+    atlas.size = glm::ivec2(header.width, header.height);
+    // Keep the file mapped, so the pixels are uploaded straight from it
+    atlas.cache = std::move(file);
+    return true;
+}
+
+void Font::saveCache(const std::string &path, uint64_t fontHash, const Atlas &atlas) {
+    FontCacheHeader header{};
+    std::memcpy(header.magic, FONT_CACHE_MAGIC, sizeof(FONT_CACHE_MAGIC));
+    header.characterSize = sizeof(Character);
+    header.fontHash = fontHash;
+    header.pixelSize = atlas.pixelSize;
+    header.width = atlas.size.x;
+    header.height = atlas.size.y;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(atlas.characters.data()), sizeof(atlas.characters));
+    out.write(reinterpret_cast<const char *>(atlas.rendered.data()), static_cast<std::streamsize>(atlas.rendered.size()));
+    if (!out) {
+        std::cout << "ERROR::FONT: Failed to save font atlas cache to " << path << std::endl;
     }
+}
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+Font::~Font() {
+    glDeleteTextures(1, &Texture);
+}
 
-    // Load first 128 characters of ASCII set
-    for (unsigned char c = 0; c < 128; c++) {
-        // load character glyph 
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
+void Font::rasterize(FT_Face face, Atlas &atlas) {
+    std::vector<unsigned char> &pixels = atlas.rendered;
+
+    // Leave a pixel between glyphs so linear filtering never samples a neighbour
+    const int PADDING = 1;
+    int x = PADDING, y = PADDING, shelfHeight = 0;
+
+    // Glyphs are placed left to right in shelves as tall as their tallest glyph, and copied into the atlas as the
+    // atlas grows downwards
+    atlas.size = glm::ivec2(ATLAS_WIDTH, 0);
+    glm::ivec2 positions[CHARACTER_COUNT] = {};
+    for (int c = 0; c < CHARACTER_COUNT; c++) {
+        // load character glyph, and render its outline as a signed distance field
+        if (FT_Load_Char(face, c, FT_LOAD_DEFAULT)) {
             std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
             continue;
         }
+        // Glyphs without an outline (e.g. space) have nothing to render, but still advance the cursor
+        bool rendered = face->glyph->outline.n_contours > 0 && FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF) == 0;
+        const FT_Bitmap &bitmap = face->glyph->bitmap;
+        int w = rendered ? static_cast<int>(bitmap.width) : 0, h = rendered ? static_cast<int>(bitmap.rows) : 0;
+
+        // start a new shelf when this glyph does not fit on the current one
+        if (x + w + PADDING > ATLAS_WIDTH) {
+            x = PADDING;
+            y += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        positions[c] = glm::ivec2(x, y);
+        shelfHeight = std::max(shelfHeight, h);
+        atlas.size.y = std::max(atlas.size.y, y + h + PADDING);
+        pixels.resize(static_cast<size_t>(atlas.size.x) * atlas.size.y, 0);
+
+        for (int row = 0; row < h; row++) {
+            std::memcpy(&pixels[static_cast<size_t>(y + row) * ATLAS_WIDTH + x],
+                        bitmap.buffer + row * bitmap.pitch, w);
+        }
 
-        // generate texture
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-
-        // set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        // now store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+        // now store character for later use; texture coordinates are filled in once the atlas size is known
+        atlas.characters[c] = {
+            glm::vec2(0.0f), glm::vec2(0.0f),
+            glm::ivec2(w, h),
             glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
             static_cast<unsigned int>(face->glyph->advance.x)
         };
-        Characters.insert(std::pair<char, Character>(c, character));
+        x += w + PADDING;
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
 
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    const glm::vec2 size(atlas.size);
+    for (int c = 0; c < CHARACTER_COUNT; c++) {
+        atlas.characters[c].UV0 = glm::vec2(positions[c]) / size;
+        atlas.characters[c].UV1 = glm::vec2(positions[c] + atlas.characters[c].Size) / size;
+    }
 }
 
-std::map<char, Character> Font::getCharacters() const {
+void Font::upload(const unsigned char *pixels) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+
+    glGenTextures(1, &Texture);
+    glBindTexture(GL_TEXTURE_2D, Texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, AtlasSize.x, AtlasSize.y, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+
+    // set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+const std::array<Character, Font::CHARACTER_COUNT> &Font::getCharacters() const {
     return Characters;
 }
+
+unsigned int Font::getTexture() const {
+    return Texture;
+}
+
+unsigned int Font::getPixelSize() const {
+    return PixelSize;
+}
@@ -1,12 +1,16 @@
 #ifndef GRAPHICS_FONT_H
 #define GRAPHICS_FONT_H
 
-#include <map>
+#include <array>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 
 #include <glm/glm.hpp>
 
+#include "../util/mappedFile.h"
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
@@ -14,13 +18,15 @@
  * @brief A single character
  * @details This struct is used to store information about a single character
  * 
- * @param TextureID ID handle of the glyph texture
+ * @param UV0 Texture coordinates of the top left corner of the glyph in the atlas
+ * @param UV1 Texture coordinates of the bottom right corner of the glyph in the atlas
  * @param Size Size of glyph
  * @param Bearing Offset from baseline to left/top of glyph
  * @param Advance Offset to advance to next glyph
  */
 struct Character {
-    unsigned int TextureID;
+    glm::vec2    UV0;
+    glm::vec2    UV1;
     glm::ivec2   Size;
     glm::ivec2   Bearing;
     unsigned int Advance;
@@ -28,32 +34,137 @@ struct Character {
 
 /**
  * @brief A font
- * @details This class is used to store information about a font
+ * @details This class is used to store information about a font. The first 128 ASCII glyphs are rendered as signed
+ * distance fields and packed into a single atlas texture, so text in this font can be drawn at any scale from one
+ * texture (text.frag turns the distance into a sharp, anti-aliased edge).
+ *
+ * The atlas and glyph metrics are cached in the cache directory, keyed by the font's resource name, size and a hash
+ * of the font file, so FreeType only runs the first time a font is used (or after the font file changes).
  */
 class Font {
     public:
+        /// @brief The number of characters loaded (the ASCII set)
+        static constexpr int CHARACTER_COUNT = 128;
+
+        /// @brief Width of the atlas texture in pixels; its height is however many rows of glyphs are needed
+        static constexpr int ATLAS_WIDTH = 512;
+
+        /// @brief Pixel size the distance fields are rendered at. One atlas at this size serves every text size.
+        static constexpr unsigned int SDF_SIZE = 32;
+
+        /**
+         * @brief A font's glyph metrics and atlas pixels, before they are uploaded
+         * @details Built without OpenGL by load(), so it can be prepared on a worker thread while the context is
+         * created. The pixels are either mapped from the cache file or rendered into memory.
+         */
+        struct Atlas {
+            std::array<Character, CHARACTER_COUNT> characters{};
+            glm::ivec2 size{0, 0};
+            unsigned int pixelSize = 0;
+
+            /// @brief The cache file, when the atlas was loaded from it
+            MappedFile cache;
+
+            /// @brief The atlas pixels when they were rendered with FreeType
+            std::vector<unsigned char> rendered;
+
+            /// @brief The atlas pixels, one byte per pixel, size.x per row
+            const unsigned char *pixels() const;
+        };
+
+        /**
+         * @brief Loads a font's atlas from the cache, or renders the glyphs' distance fields into it and caches it
+         * @details Makes no OpenGL calls, so it is safe on any thread
+         *
+         * @param fontPath The font's resource name (e.g. "fonts/MxPlus_IBM_BIOS.ttf")
+         * @param fontSize The pixel size to render the distance fields at (usually SDF_SIZE)
+         */
+        static Atlas load(const std::string &fontPath, unsigned int fontSize = SDF_SIZE);
+
         /**
          * @brief Construct a new Font object
+         * @details Calls load() and uploads the atlas as one texture
          * 
-         * @param fontPath The path to the font file
-         * @param fontSize The size of the font
+         * @param fontPath The font's resource name (e.g. "fonts/MxPlus_IBM_BIOS.ttf")
+         * @param fontSize The pixel size to render the distance fields at (usually SDF_SIZE)
+         */
+        Font(std::string fontPath, unsigned int fontSize = SDF_SIZE);
+
+        /**
+         * @brief Construct a new Font object from an atlas prepared by load(), uploading it as one texture
          */
-        Font(std::string fontPath, unsigned int fontSize);
+        explicit Font(const Atlas &atlas);
+
+        Font(Font const &other) = delete;
+        Font &operator=(Font const &other) = delete;
+
+        /**
+         * @brief Destroy the Font object and delete its atlas texture
+         */
+        ~Font();
 
-        
         /**
          * @brief Get the characters
          * 
-         * @return a map of characters
+         * @return the characters, indexed by ASCII code
+         */
+        const std::array<Character, CHARACTER_COUNT> &getCharacters() const;
+
+        /**
+         * @brief Get the atlas texture holding every glyph
          */
-        std::map<char, Character> getCharacters() const;
+        unsigned int getTexture() const;
+
+        /**
+         * @brief Get the pixel size the glyphs were rendered at (the size of text drawn at scale 1)
+         */
+        unsigned int getPixelSize() const;
 
     private:
         /**
-         * @brief A set of character structs mapped to their ASCII character representations
+         * @brief A set of character structs indexed by their ASCII character representations
+         */
+        std::array<Character, CHARACTER_COUNT> Characters{};
+
+        /**
+         * @brief The atlas texture, and its size in pixels
+         */
+        unsigned int Texture = 0;
+        glm::ivec2 AtlasSize{0, 0};
+
+        /**
+         * @brief The pixel size the glyphs were rendered at
+         */
+        unsigned int PixelSize;
+
+        /**
+         * @brief Renders every glyph's distance field and packs them into rows (shelves) of a single-channel atlas
+         * @details Each field extends FreeType's SDF spread (8 pixels) past the outline, and 128 is the edge
+         * @param face The font face, with its pixel size set
+         * @param atlas The atlas to fill in; its pixels go in rendered, ATLAS_WIDTH per row
          */
-        std::map<char, Character> Characters;
+        static void rasterize(FT_Face face, Atlas &atlas);
 
+        /**
+         * @brief Uploads the atlas pixels as the font's texture
+         */
+        void upload(const unsigned char *pixels);
+
+        /**
+         * @brief Returns the cache file of a font's atlas, from the font's resource name and size
+         */
+        static std::string cacheFile(const std::string &fontPath, unsigned int fontSize);
+
+        /**
+         * @brief Memory-maps a cached atlas and checks it matches the font file's hash
+         * @return false if there is no valid cache file, so the atlas has to be rendered
+         */
+        static bool loadCache(const std::string &path, uint64_t fontHash, Atlas &atlas);
+
+        /**
+         * @brief Writes the atlas and glyph metrics to a cache file
+         */
+        static void saveCache(const std::string &path, uint64_t fontHash, const Atlas &atlas);
 };
 
 #endif //GRAPHICS_FONT_H
@@ -3,11 +3,13 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
-FontRenderer::FontRenderer(Shader& shader, std::string fontPath, int fontSize) {
+FontRenderer::FontRenderer(Shader& shader, std::string fontPath, int fontSize)
+        : FontRenderer(shader, Font::load(fontPath), fontSize) {}
+
+FontRenderer::FontRenderer(Shader& shader, const Font::Atlas &atlas, int fontSize)
+        : font(atlas), sizeScale(font.getPixelSize() > 0 ? static_cast<float>(fontSize) / font.getPixelSize() : 1.0f) {
     this->shader = shader;
     this->initRenderData();
-    Font myFont(fontPath, fontSize);
-    this->font = myFont.getCharacters();
 }
 
 FontRenderer::~FontRenderer() {
@@ -20,54 +22,81 @@ void FontRenderer::initRenderData() {
     glGenBuffers(1, &this->VBO);
     glBindVertexArray(this->VAO);
     glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    // <vec2 pos, vec2 tex> and <vec3 color>
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, VERTEX_FLOATS * sizeof(float), 0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_FLOATS * sizeof(float), (void*)(4 * sizeof(float)));
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void FontRenderer::renderText(std::string text, float x, float y, float scale, glm::vec3 color) {
-    // activate corresponding render state
+void FontRenderer::renderText(std::string_view text, float x, float y, float scale, glm::vec3 color) {
+    layoutText(text, x, y, scale, color, vertices);
+}
 
-    this->shader.use();
-    glUniformMatrix4fv(glGetUniformLocation(this->shader.ID, "projection"), 1, false, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(this->shader.ID, "textColor"), color.x, color.y, color.z);
+void FontRenderer::reserve(size_t glyphs) {
+    vertices.reserve(glyphs * GLYPH_FLOATS);
+}
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(this->VAO);
+void FontRenderer::queue(const std::vector<float> &run) {
+    vertices.insert(vertices.end(), run.begin(), run.end());
+}
+
+void FontRenderer::layoutText(std::string_view text, float x, float y, float scale, glm::vec3 color,
+                              std::vector<float> &out) const {
+    const std::array<Character, Font::CHARACTER_COUNT> &characters = font.getCharacters();
+    scale *= sizeScale;
 
     // iterate through all characters
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        Character ch = font[*c];
+    for (char c : text) {
+        unsigned char code = static_cast<unsigned char>(c);
+        if (code >= Font::CHARACTER_COUNT)
+            continue;
+        const Character &ch = characters[code];
 
         float xpos = x + ch.Bearing.x * scale;
         float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
 
         float w = ch.Size.x * scale;
         float h = ch.Size.y * scale;
-        // update VBO for each character
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 0.0f },            
-            { xpos,     ypos,       0.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-
-            { xpos,     ypos + h,   0.0f, 0.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-            { xpos + w, ypos + h,   1.0f, 0.0f }           
+        // two triangles covering the glyph's rectangle in the atlas
+        const float quad[6][VERTEX_FLOATS] = {
+            { xpos,     ypos + h,   ch.UV0.x, ch.UV0.y, color.x, color.y, color.z },
+            { xpos,     ypos,       ch.UV0.x, ch.UV1.y, color.x, color.y, color.z },
+            { xpos + w, ypos,       ch.UV1.x, ch.UV1.y, color.x, color.y, color.z },
+
+            { xpos,     ypos + h,   ch.UV0.x, ch.UV0.y, color.x, color.y, color.z },
+            { xpos + w, ypos,       ch.UV1.x, ch.UV1.y, color.x, color.y, color.z },
+            { xpos + w, ypos + h,   ch.UV1.x, ch.UV0.y, color.x, color.y, color.z }
         };
-        // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-        // update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        out.insert(out.end(), &quad[0][0], &quad[0][0] + 6 * VERTEX_FLOATS);
         // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
         x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
     }
+}
+
+void FontRenderer::flush() {
+    if (vertices.empty())
+        return;
+
+    // activate corresponding render state
+    this->shader.use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, font.getTexture());
+    glBindVertexArray(this->VAO);
+
+    // upload every queued glyph at once, growing the buffer when the text no longer fits
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (vertices.size() > capacity) {
+        capacity = vertices.capacity();
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(float), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size() / VERTEX_FLOATS));
+    vertices.clear();
 
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -5,22 +5,47 @@
 #include "../shader/shader.h"
 #include "font.h"
 
+#include <string_view>
+#include <vector>
+
 /**
  * @brief A font renderer
- * @details This class is used to render text using a font
+ * @details This class is used to render text using a font. Text is batched: renderText() only appends the glyph
+ * quads (with their colour) to a vertex stream, and flush() draws everything queued with one draw call, since every
+ * glyph is in the font's atlas texture.
  */
 class FontRenderer {
     public:
+        /**
+         * @brief Floats per vertex: position (2), texture coordinates (2) and colour (3)
+         */
+        static constexpr int VERTEX_FLOATS = 7;
+
+        /**
+         * @brief Floats per glyph: two triangles of VERTEX_FLOATS each
+         */
+        static constexpr int GLYPH_FLOATS = 6 * VERTEX_FLOATS;
+
         /**
          * @brief Construct a new Font Renderer object
          * @details This constructor will call the font constructor and initialize the render data
          * 
          * @param shader The shader to use
-         * @param fontPath The path to the font file
-         * @param fontSize The size of the font
+         * @param fontPath The font's resource name (e.g. "fonts/MxPlus_IBM_BIOS.ttf")
+         * @param fontSize The pixel size of text drawn at scale 1 (the atlas itself is rendered at Font::SDF_SIZE)
          */
         FontRenderer(Shader& shader, std::string fontPath, int fontSize);
 
+        /**
+         * @brief Construct a new Font Renderer object from an atlas already loaded by Font::load()
+         * @details Only uploads the atlas, so the loading can happen on another thread first
+         *
+         * @param shader The shader to use
+         * @param atlas The font's atlas
+         * @param fontSize The pixel size of text drawn at scale 1
+         */
+        FontRenderer(Shader& shader, const Font::Atlas &atlas, int fontSize);
+
         /**
          * @brief Destroy the Font Renderer object
          * @details destroys the VAO and VBO associated with the font renderer
@@ -28,7 +53,7 @@ class FontRenderer {
         ~FontRenderer();
 
         /**
-         * @brief Renders text on the screen
+         * @brief Queues text to render on the screen with the next flush()
          * 
          * @param text The text to render
          * @param x The x position of the text
@@ -36,7 +61,31 @@ class FontRenderer {
          * @param scale The scale of the text
          * @param color The color of the text
          */
-        void renderText(std::string text, float x, float y, float scale, glm::vec3 color);
+        void renderText(std::string_view text, float x, float y, float scale, glm::vec3 color);
+
+        /**
+         * @brief Lays out text as glyph quads, appending them to a vertex run
+         * @details Used by TextLabel to keep the layout of text that does not change between frames
+         *
+         * @param out The vertex run to append to, in this renderer's vertex format
+         */
+        void layoutText(std::string_view text, float x, float y, float scale, glm::vec3 color,
+                        std::vector<float> &out) const;
+
+        /**
+         * @brief Queues an already laid out vertex run (see layoutText()) to render with the next flush()
+         */
+        void queue(const std::vector<float> &run);
+
+        /**
+         * @brief Makes room for this many glyphs per frame, so queueing them never allocates
+         */
+        void reserve(size_t glyphs);
+
+        /**
+         * @brief Draws all the text queued since the last flush with one draw call
+         */
+        void flush();
 
     private:
         /**
@@ -50,15 +99,25 @@ class FontRenderer {
         GLuint VAO, VBO;
 
         /**
-         * @brief The projection matrix
+         * @brief The number of floats the VBO can hold before it has to be reallocated
+         */
+        size_t capacity = 0;
+
+        /**
+         * @brief The font, with every glyph in one atlas texture
+         */
+        Font font;
+
+        /**
+         * @brief Converts the atlas size to the requested font size, applied on top of each call's scale
          */
-        glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 600.0f); // TODO: decide if this should be here or constant in engine class
+        float sizeScale;
 
         /**
-         * @brief A set of character structs mapped to their ASCII character representations
-         * @details This is the same map generated by the font class
+         * @brief The vertices queued by renderText() since the last flush
+         * @details Kept between frames so its memory is reused
          */
-        std::map<char, Character> font;
+        std::vector<float> vertices;
 
         /**
          * @brief Initializes and configures the buffer and vertex attributes
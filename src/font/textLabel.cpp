@@ -0,0 +1,45 @@
+#include "textLabel.h"
+#include "fontRenderer.h"
+
+TextLabel::TextLabel(std::string_view text, float x, float y, float scale, glm::vec3 color)
+        : text(text), x(x), y(y), scale(scale), color(color) {
+    // so the first draw lays the text out without allocating
+    vertices.reserve(text.size() * FontRenderer::GLYPH_FLOATS);
+}
+
+void TextLabel::reserve(size_t length) {
+    text.reserve(length);
+    vertices.reserve(length * FontRenderer::GLYPH_FLOATS);
+}
+
+void TextLabel::setText(std::string_view text) {
+    if (text == this->text)
+        return;
+    // assign() reuses the string's memory when the new text fits
+    this->text.assign(text.data(), text.size());
+    dirty = true;
+}
+
+void TextLabel::setPosition(float x, float y) {
+    this->x = x;
+    this->y = y;
+    dirty = true;
+}
+
+void TextLabel::setColor(glm::vec3 color) {
+    this->color = color;
+    dirty = true;
+}
+
+std::string_view TextLabel::getText() const {
+    return text;
+}
+
+void TextLabel::draw(FontRenderer &renderer) {
+    if (dirty) {
+        vertices.clear();
+        renderer.layoutText(text, x, y, scale, color, vertices);
+        dirty = false;
+    }
+    renderer.queue(vertices);
+}
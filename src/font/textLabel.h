@@ -0,0 +1,51 @@
+#ifndef GRAPHICS_TEXTLABEL_H
+#define GRAPHICS_TEXTLABEL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+class FontRenderer;
+
+/**
+ * @brief A piece of text kept between frames, with its glyph quads laid out once.
+ * @details The vertex run is only rebuilt when the text, position, scale or colour changes, so drawing an unchanged
+ * label just copies its vertices into the renderer's batch. Once the label has room for its longest text (see
+ * reserve()), neither changing nor drawing it allocates.
+ */
+class TextLabel {
+public:
+    TextLabel() = default;
+
+    /// @brief Construct a label. Positions, scale and colour are as for FontRenderer::renderText().
+    TextLabel(std::string_view text, float x, float y, float scale, glm::vec3 color);
+
+    /// @brief Changes the text. Does nothing if it is the same.
+    void setText(std::string_view text);
+
+    /// @brief Makes room for text of up to length characters, so setting and drawing it never allocates.
+    /// @details The constructor already makes room for its own text; this is for labels whose text grows later.
+    void reserve(size_t length);
+
+    void setPosition(float x, float y);
+    void setColor(glm::vec3 color);
+
+    std::string_view getText() const;
+
+    /// @brief Queues the label with a renderer, laying it out again first if it changed.
+    void draw(FontRenderer &renderer);
+
+private:
+    std::string text;
+    float x = 0, y = 0, scale = 1;
+    glm::vec3 color{1, 1, 1};
+
+    /// @brief The laid out glyph quads, in FontRenderer's vertex format.
+    std::vector<float> vertices;
+
+    /// @brief Whether the vertices are out of date.
+    bool dirty = true;
+};
+
+#endif //GRAPHICS_TEXTLABEL_H
@@ -0,0 +1,157 @@
+#include "batchSolver.h"
+#include "bitMatrix.h"
+#include "bits.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+/// @brief Words per slice: BLOCK boards, one bit each.
+static constexpr int SLICE_WORDS = BatchSolver::BLOCK / 64;
+
+/// @brief Transposes a 64x64 bit matrix in place (bit i of a[k] swaps with bit k of a[i]).
+static void transpose64(uint64_t a[64]) {
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = ((a[k] >> j) ^ a[k | j]) & mask;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+}
+
+// --------------------------------------------------------
+// Matrix kernels: out[i] = XOR of slices[j] for every bit j of matrix[i]
+// --------------------------------------------------------
+
+static void applyScalar(const uint64_t *matrix, size_t outRows, const uint64_t *slices, uint64_t *out) {
+    for (size_t i = 0; i < outRows; i++) {
+        uint64_t acc[SLICE_WORDS] = {};
+        for (uint64_t m = matrix[i]; m; m &= m - 1) {
+            const uint64_t *slice = slices + countTrailingZeros64(m) * SLICE_WORDS;
+            for (int w = 0; w < SLICE_WORDS; w++)
+                acc[w] ^= slice[w];
+        }
+        std::copy(acc, acc + SLICE_WORDS, out + i * SLICE_WORDS);
+    }
+}
+
+#if defined(SIMD_HAVE_AVX2)
+SIMD_TARGET("avx2")
+static void applyAvx2(const uint64_t *matrix, size_t outRows, const uint64_t *slices, uint64_t *out) {
+    static_assert(SLICE_WORDS == 4, "one AVX2 register per slice");
+    for (size_t i = 0; i < outRows; i++) {
+        __m256i acc = _mm256_setzero_si256();
+        for (uint64_t m = matrix[i]; m; m &= m - 1) {
+            const uint64_t *slice = slices + countTrailingZeros64(m) * SLICE_WORDS;
+            acc = _mm256_xor_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(slice)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i * SLICE_WORDS), acc);
+    }
+}
+#endif
+
+// --------------------------------------------------------
+// BatchSolver
+// --------------------------------------------------------
+
+BatchSolver::BatchSolver(int rows, int cols) : rows(rows), cols(cols), cells(rows * cols) {
+    if (rows <= 0 || cols <= 0 || cells > 64) {
+        throw std::invalid_argument("BatchSolver: the board must fit in 64 bits");
+    }
+    useSimd = cpuHasAvx2();
+
+    // The press matrix is symmetric, so row i is the toggle mask of cell i. Reduce [A | I] to record the row
+    // operations: pivot rows give the solve matrix, rows without a pivot give the solvability checks.
+    BitMatrix matrix(cells, 128);
+    for (int i = 0; i < cells; i++) {
+        Board pressed(rows, cols);
+        pressed.press(i / cols, i % cols);
+        matrix.row(i)[0] = pack(pressed);
+        matrix.set(i, 64 + i, true);
+    }
+    std::vector<int> pivots = matrix.reduce(cells);
+
+    solveRows.assign(cells, 0);
+    for (size_t r = 0; r < pivots.size(); r++)
+        solveRows[pivots[r]] = matrix.row(static_cast<int>(r))[1];
+    for (int r = static_cast<int>(pivots.size()); r < cells; r++)
+        checkRows.push_back(matrix.row(r)[1]);
+}
+
+void BatchSolver::solve(const uint64_t *boards, size_t count, uint64_t *solutions, int *pressCounts) const {
+    std::vector<uint64_t> slices(64 * SLICE_WORDS), presses(64 * SLICE_WORDS), checks(64 * SLICE_WORDS);
+    uint64_t block[64];
+
+    for (size_t start = 0; start < count; start += BLOCK) {
+        size_t inBlock = std::min<size_t>(BLOCK, count - start);
+
+        // Bit-slice: word w of slice k holds cell k of boards [64w, 64w + 64) of the block
+        for (int w = 0; w < SLICE_WORDS; w++) {
+            for (int b = 0; b < 64; b++) {
+                size_t index = static_cast<size_t>(w) * 64 + b;
+                block[b] = index < inBlock ? boards[start + index] : 0;
+            }
+            transpose64(block);
+            for (int k = 0; k < 64; k++)
+                slices[k * SLICE_WORDS + w] = block[k];
+        }
+
+#if defined(SIMD_HAVE_AVX2)
+        if (useSimd) {
+            applyAvx2(solveRows.data(), solveRows.size(), slices.data(), presses.data());
+            applyAvx2(checkRows.data(), checkRows.size(), slices.data(), checks.data());
+        } else
+#endif
+        {
+            applyScalar(solveRows.data(), solveRows.size(), slices.data(), presses.data());
+            applyScalar(checkRows.data(), checkRows.size(), slices.data(), checks.data());
+        }
+
+        // Un-slice: transpose back, and mark the boards that failed any check
+        for (int w = 0; w < SLICE_WORDS; w++) {
+            uint64_t unsolvable = 0;
+            for (size_t k = 0; k < checkRows.size(); k++)
+                unsolvable |= checks[k * SLICE_WORDS + w];
+            for (int k = 0; k < 64; k++)
+                block[k] = k < cells ? presses[k * SLICE_WORDS + w] : 0;
+            transpose64(block);
+            for (int b = 0; b < 64; b++) {
+                size_t index = static_cast<size_t>(w) * 64 + b;
+                if (index >= inBlock)
+                    break;
+                bool solvable = !((unsolvable >> b) & 1);
+                solutions[start + index] = solvable ? block[b] : 0;
+                pressCounts[start + index] = solvable ? popcount64(block[b]) : -1;
+            }
+        }
+    }
+}
+
+void BatchSolver::setUseSimd(bool useSimd) {
+    this->useSimd = useSimd && cpuHasAvx2();
+}
+
+bool BatchSolver::isUsingSimd() const {
+    return useSimd;
+}
+
+uint64_t BatchSolver::pack(const Board &board) {
+    uint64_t packed = 0;
+    for (int r = 0; r < board.getRows(); r++)
+        packed |= board.getRow(r)[0] << (r * board.getCols());
+    return packed;
+}
+
+Board BatchSolver::unpack(uint64_t packed, int rows, int cols) {
+    Board board(rows, cols);
+    for (int r = 0; r < rows; r++) {
+        uint64_t row = cols == 64 ? packed : (packed >> (r * cols)) & ((uint64_t(1) << cols) - 1);
+        board.setRow(r, &row);
+    }
+    return board;
+}
+
+int BatchSolver::getRows() const { return rows; }
+int BatchSolver::getCols() const { return cols; }
@@ -0,0 +1,61 @@
+#ifndef GRAPHICS_BATCHSOLVER_H
+#define GRAPHICS_BATCHSOLVER_H
+
+#include "board.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Solves many small boards at once with bit-sliced matrix products.
+ * @details Boards of up to 64 cells are packed one per word (bit row * cols + col). Each block of BLOCK boards is
+ * transposed into bit-sliced form: slice k holds cell k of every board, one board per bit. Pressing according to the
+ * solve matrix is then one XOR of whole slices per matrix entry, which solves every board of the block in the same
+ * instruction (256 boards per AVX2 register, 64 per word in the scalar fallback). The solutions are transposed back
+ * and counted with popcount.
+ * The toggle masks come from Board::press(), the same model the interactive game uses.
+ */
+class BatchSolver {
+public:
+    /// @brief The number of boards solved together.
+    static constexpr int BLOCK = 256;
+
+    /// @brief Builds the solve matrix for rows x cols boards (rows * cols must be at most 64).
+    BatchSolver(int rows, int cols);
+
+    /// @brief Solves a batch of packed boards.
+    /// @param boards count packed boards
+    /// @param count The number of boards (any number; the last block is padded)
+    /// @param solutions Receives the packed presses of each board (0 if it cannot be solved)
+    /// @param pressCounts Receives the number of presses of each board (-1 if it cannot be solved)
+    void solve(const uint64_t *boards, size_t count, uint64_t *solutions, int *pressCounts) const;
+
+    /// @brief Forces the scalar kernel (e.g. for benchmarking) or goes back to the fastest supported one.
+    void setUseSimd(bool useSimd);
+
+    /// @brief Returns true if the AVX2 kernel is in use.
+    bool isUsingSimd() const;
+
+    /// @brief Packs a board one cell per bit (bit row * cols + col).
+    static uint64_t pack(const Board &board);
+
+    /// @brief Unpacks a packed board.
+    static Board unpack(uint64_t packed, int rows, int cols);
+
+    int getRows() const;
+    int getCols() const;
+
+private:
+    int rows, cols, cells;
+
+    /// @brief Row i: the board cells whose XOR gives press i.
+    std::vector<uint64_t> solveRows;
+
+    /// @brief A board is unsolvable if the XOR of the cells in any of these rows is 1.
+    std::vector<uint64_t> checkRows;
+
+    bool useSimd;
+};
+
+#endif //GRAPHICS_BATCHSOLVER_H
@@ -0,0 +1,194 @@
+#include "bitMatrix.h"
+#include "bits.h"
+#include "simd.h"
+
+#include <algorithm>
+
+// --------------------------------------------------------
+// XOR kernels
+// --------------------------------------------------------
+
+static void xorWordsScalar(uint64_t *dst, const uint64_t *src, size_t count) {
+    for (size_t i = 0; i < count; i++)
+        dst[i] ^= src[i];
+}
+
+#if defined(SIMD_HAVE_SSE2)
+SIMD_TARGET("sse2")
+static void xorWordsSse2(uint64_t *dst, const uint64_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_xor_si128(a, b));
+    }
+    for (; i < count; i++)
+        dst[i] ^= src[i];
+}
+#endif
+
+#if defined(SIMD_HAVE_AVX2)
+SIMD_TARGET("avx2")
+static void xorWordsAvx2(uint64_t *dst, const uint64_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(a, b));
+    }
+    for (; i < count; i++)
+        dst[i] ^= src[i];
+}
+#endif
+
+namespace gf2 {
+    using XorFn = void (*)(uint64_t *, const uint64_t *, size_t);
+
+    static bool cpuSupports(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Scalar: return true;
+            case Kernel::SSE2:   return cpuHasSse2();
+            case Kernel::AVX2:   return cpuHasAvx2();
+        }
+        return false;
+    }
+
+    static XorFn kernelFn(Kernel kernel) {
+        switch (kernel) {
+#if defined(SIMD_HAVE_AVX2)
+            case Kernel::AVX2: return xorWordsAvx2;
+#endif
+#if defined(SIMD_HAVE_SSE2)
+            case Kernel::SSE2: return xorWordsSse2;
+#endif
+            default: return xorWordsScalar;
+        }
+    }
+
+    static Kernel bestKernel() {
+        if (cpuSupports(Kernel::AVX2)) return Kernel::AVX2;
+        if (cpuSupports(Kernel::SSE2)) return Kernel::SSE2;
+        return Kernel::Scalar;
+    }
+
+    /// @brief The kernel in use. A function-local static, so it is ready even during static initialisation.
+    struct Dispatch {
+        Kernel kernel;
+        XorFn fn;
+    };
+
+    static Dispatch &active() {
+        static Dispatch dispatch{bestKernel(), kernelFn(bestKernel())};
+        return dispatch;
+    }
+
+    void xorWords(uint64_t *dst, const uint64_t *src, size_t count) {
+        active().fn(dst, src, count);
+    }
+
+    Kernel getKernel() {
+        return active().kernel;
+    }
+
+    bool setKernel(Kernel kernel) {
+        if (!cpuSupports(kernel))
+            return false;
+        active() = Dispatch{kernel, kernelFn(kernel)};
+        return true;
+    }
+
+    const char *kernelName(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Scalar: return "scalar";
+            case Kernel::SSE2:   return "sse2";
+            case Kernel::AVX2:   return "avx2";
+        }
+        return "unknown";
+    }
+}
+
+// --------------------------------------------------------
+// BitMatrix
+// --------------------------------------------------------
+
+BitMatrix::BitMatrix(int rows, int cols) : rows(rows), cols(cols) {
+    stride = (wordsForBits(cols) + 3) & ~3;
+    words.assign(static_cast<size_t>(rows) * stride, 0);
+}
+
+BitMatrix BitMatrix::identity(int size) {
+    BitMatrix m(size, size);
+    for (int i = 0; i < size; i++)
+        m.set(i, i, true);
+    return m;
+}
+
+bool BitMatrix::get(int r, int c) const {
+    return (row(r)[c / 64] >> (c % 64)) & 1;
+}
+
+void BitMatrix::set(int r, int c, bool value) {
+    uint64_t bit = uint64_t(1) << (c % 64);
+    if (value)
+        row(r)[c / 64] |= bit;
+    else
+        row(r)[c / 64] &= ~bit;
+}
+
+void BitMatrix::flip(int r, int c) {
+    row(r)[c / 64] ^= uint64_t(1) << (c % 64);
+}
+
+uint64_t *BitMatrix::row(int r)             { return words.data() + static_cast<size_t>(r) * stride; }
+const uint64_t *BitMatrix::row(int r) const { return words.data() + static_cast<size_t>(r) * stride; }
+
+void BitMatrix::xorRow(int dst, int src) {
+    gf2::xorWords(row(dst), row(src), stride);
+}
+
+void BitMatrix::xorRow(int dst, const uint64_t *src) {
+    gf2::xorWords(row(dst), src, stride);
+}
+
+void BitMatrix::swapRows(int a, int b) {
+    if (a != b)
+        std::swap_ranges(row(a), row(a) + stride, row(b));
+}
+
+void BitMatrix::clear() {
+    std::fill(words.begin(), words.end(), 0);
+}
+
+std::vector<int> BitMatrix::reduce(int pivotCols) {
+    std::vector<int> pivots;
+    int pivotRow = 0;
+    for (int col = 0; col < pivotCols && pivotRow < rows; col++) {
+        // Find a row at or below pivotRow with a 1 in this column
+        int found = -1;
+        for (int r = pivotRow; r < rows; r++) {
+            if (get(r, col)) {
+                found = r;
+                break;
+            }
+        }
+        if (found < 0)
+            continue;
+        swapRows(pivotRow, found);
+
+        // Clear the column in every other row (Gauss-Jordan), so the result is fully reduced.
+        // Words before col / 64 are zero in the pivot row, so they can be skipped.
+        int firstWord = col / 64;
+        const uint64_t *pivot = row(pivotRow) + firstWord;
+        for (int r = 0; r < rows; r++) {
+            if (r != pivotRow && get(r, col))
+                gf2::xorWords(row(r) + firstWord, pivot, stride - firstWord);
+        }
+        pivots.push_back(col);
+        pivotRow++;
+    }
+    return pivots;
+}
+
+int BitMatrix::getRows() const   { return rows; }
+int BitMatrix::getCols() const   { return cols; }
+int BitMatrix::getStride() const { return stride; }
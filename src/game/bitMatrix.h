@@ -0,0 +1,79 @@
+#ifndef GRAPHICS_BITMATRIX_H
+#define GRAPHICS_BITMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Word-parallel kernels for linear algebra over GF(2).
+ * @details Adding two rows over GF(2) is a XOR, so row operations boil down to xorWords(). The fastest kernel the
+ * CPU supports (AVX2, SSE2 or portable scalar) is picked the first time it is used.
+ */
+namespace gf2 {
+    enum class Kernel { Scalar, SSE2, AVX2 };
+
+    /// @brief dst[i] ^= src[i] for i in [0, count).
+    void xorWords(uint64_t *dst, const uint64_t *src, size_t count);
+
+    /// @brief Returns the kernel xorWords() currently dispatches to.
+    Kernel getKernel();
+
+    /// @brief Forces a kernel (e.g. for benchmarking). Returns false if the CPU does not support it.
+    bool setKernel(Kernel kernel);
+
+    /// @brief Returns a printable name for a kernel.
+    const char *kernelName(Kernel kernel);
+}
+
+/**
+ * @brief A dense matrix over GF(2) with every row packed into 64-bit words.
+ * @details Rows are padded to a multiple of 256 bits so whole rows can be processed with AVX2 without a tail.
+ */
+class BitMatrix {
+public:
+    /// @brief Construct a rows x cols matrix of zeros.
+    BitMatrix(int rows = 0, int cols = 0);
+
+    /// @brief Returns a size x size identity matrix.
+    static BitMatrix identity(int size);
+
+    bool get(int row, int col) const;
+    void set(int row, int col, bool value);
+    void flip(int row, int col);
+
+    /// @brief Returns the packed words of a row (getStride() words, bits past getCols() are zero).
+    uint64_t *row(int row);
+    const uint64_t *row(int row) const;
+
+    /// @brief row(dst) ^= row(src).
+    void xorRow(int dst, int src);
+
+    /// @brief row(dst) ^= a row of another matrix with the same stride.
+    void xorRow(int dst, const uint64_t *src);
+
+    void swapRows(int a, int b);
+
+    /// @brief Sets every bit to zero.
+    void clear();
+
+    /// @brief Reduces the matrix to reduced row echelon form in place.
+    /// @details Only the first pivotCols columns are eliminated; any columns after them are carried along as an
+    /// augmented block (e.g. an identity matrix to record the row operations).
+    /// @return The pivot column of each of the first rank rows, so the rank is the size of the result
+    std::vector<int> reduce(int pivotCols);
+
+    int getRows() const;
+    int getCols() const;
+    int getStride() const;
+
+private:
+    int rows, cols;
+
+    /// @brief Number of words per row, a multiple of 4.
+    int stride;
+
+    std::vector<uint64_t> words;
+};
+
+#endif //GRAPHICS_BITMATRIX_H
@@ -0,0 +1,40 @@
+#ifndef GRAPHICS_BITS_H
+#define GRAPHICS_BITS_H
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// @brief Returns the number of set bits in a 64-bit word.
+inline int popcount64(uint64_t word) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(word));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+/// @brief Returns 1 if an odd number of bits are set in a 64-bit word, 0 otherwise.
+inline int parity64(uint64_t word) {
+    return popcount64(word) & 1;
+}
+
+/// @brief Returns the index of the lowest set bit of a non-zero 64-bit word.
+inline int countTrailingZeros64(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/// @brief Returns the number of 64-bit words needed to hold the given number of bits.
+inline int wordsForBits(int bits) {
+    return (bits + 63) / 64;
+}
+
+#endif //GRAPHICS_BITS_H
@@ -0,0 +1,117 @@
+#include "board.h"
+#include "bits.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+Board::Board(int rows, int cols) : rows(rows), cols(cols), litCount(0) {
+    if (rows <= 0 || cols <= 0 || rows > MAX_SIZE || cols > MAX_SIZE) {
+        throw std::invalid_argument("Board: dimensions must be between 1 and MAX_SIZE");
+    }
+    wordsPerRow = wordsForBits(cols);
+    lastWordMask = (cols % 64 == 0) ? ~uint64_t(0) : (uint64_t(1) << (cols % 64)) - 1;
+    words.assign(static_cast<size_t>(rows) * wordsPerRow, 0);
+}
+
+void Board::flip(int row, int word, uint64_t mask) {
+    uint64_t &w = words[static_cast<size_t>(row) * wordsPerRow + word];
+    litCount -= popcount64(w);
+    w ^= mask;
+    litCount += popcount64(w);
+}
+
+void Board::press(int row, int col) {
+    int word = col / 64;
+    uint64_t bit = uint64_t(1) << (col % 64);
+
+    // The cell and its left/right neighbours, spilling into the adjacent word at the edges
+    uint64_t triple = bit | (bit << 1) | (bit >> 1);
+    if (word == wordsPerRow - 1)
+        triple &= lastWordMask;
+    flip(row, word, triple);
+    if (bit == 1 && word > 0)
+        flip(row, word - 1, uint64_t(1) << 63);
+    if ((bit >> 63) && word + 1 < wordsPerRow)
+        flip(row, word + 1, 1);
+
+    // The neighbours above and below
+    if (row > 0)
+        flip(row - 1, word, bit);
+    if (row + 1 < rows)
+        flip(row + 1, word, bit);
+}
+
+void Board::pressRow(int row, const uint64_t *presses) {
+    for (int i = 0; i < wordsPerRow; i++) {
+        uint64_t p = presses[i];
+        if (i == wordsPerRow - 1)
+            p &= lastWordMask;
+        uint64_t prev = i > 0 ? presses[i - 1] : 0;
+        uint64_t next = i + 1 < wordsPerRow ? presses[i + 1] : 0;
+        if (i + 1 == wordsPerRow - 1)
+            next &= lastWordMask;
+
+        // Each press toggles its own column and the columns either side of it
+        uint64_t spread = p ^ (p << 1) ^ (p >> 1) ^ (prev >> 63) ^ (next << 63);
+        if (i == wordsPerRow - 1)
+            spread &= lastWordMask;
+
+        if (spread)
+            flip(row, i, spread);
+        if (p && row > 0)
+            flip(row - 1, i, p);
+        if (p && row + 1 < rows)
+            flip(row + 1, i, p);
+    }
+}
+
+void Board::toggle(int row, int col) {
+    flip(row, col / 64, uint64_t(1) << (col % 64));
+}
+
+void Board::clear() {
+    std::fill(words.begin(), words.end(), 0);
+    litCount = 0;
+}
+
+Board &Board::operator^=(const Board &other) {
+    litCount = 0;
+    for (size_t i = 0; i < words.size(); i++) {
+        words[i] ^= other.words[i];
+        litCount += popcount64(words[i]);
+    }
+    return *this;
+}
+
+bool Board::operator==(const Board &other) const {
+    return rows == other.rows && cols == other.cols && words == other.words;
+}
+
+bool Board::operator!=(const Board &other) const {
+    return !(*this == other);
+}
+
+// Getters
+bool Board::isLit(int row, int col) const {
+    return (words[static_cast<size_t>(row) * wordsPerRow + col / 64] >> (col % 64)) & 1;
+}
+bool Board::isSolved() const            { return litCount == 0; }
+int Board::getLitCount() const          { return litCount; }
+int Board::getRows() const              { return rows; }
+int Board::getCols() const              { return cols; }
+int Board::getCellCount() const         { return rows * cols; }
+int Board::getWordsPerRow() const       { return wordsPerRow; }
+uint64_t Board::getLastWordMask() const { return lastWordMask; }
+const uint64_t *Board::getRow(int row) const {
+    return words.data() + static_cast<size_t>(row) * wordsPerRow;
+}
+
+// Setters
+void Board::setRow(int row, const uint64_t *newWords) {
+    for (int i = 0; i < wordsPerRow; i++) {
+        uint64_t w = newWords[i];
+        if (i == wordsPerRow - 1)
+            w &= lastWordMask;
+        flip(row, i, words[static_cast<size_t>(row) * wordsPerRow + i] ^ w);
+    }
+}
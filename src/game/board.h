@@ -0,0 +1,89 @@
+#ifndef GRAPHICS_BOARD_H
+#define GRAPHICS_BOARD_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The Lights Out game state.
+ * @details Every row of lights is packed into 64-bit words (bit col % 64 of word col / 64), so a press updates
+ * each affected row with a few shift/XOR word operations instead of per-cell branches. The number of lit cells is
+ * kept up to date as words change, so the solved check is a single compare.
+ * The board knows nothing about rendering, so it can be driven headless (e.g. for simulations).
+ */
+class Board {
+public:
+    /// @brief The largest supported number of rows or columns.
+    static constexpr int MAX_SIZE = 4096;
+
+    /// @brief Construct a new Board with every light off.
+    /// @param rows The number of rows (1 to MAX_SIZE)
+    /// @param cols The number of columns (1 to MAX_SIZE)
+    Board(int rows = 5, int cols = 5);
+
+    /// @brief Presses a cell, toggling it and its orthogonal neighbours.
+    void press(int row, int col);
+
+    /// @brief Presses every cell of a row whose bit is set in presses.
+    /// @details Equivalent to calling press() for each set bit, but done a word at a time.
+    /// @param row The row to press in
+    /// @param presses getWordsPerRow() words with one bit per column (bits past the last column are ignored)
+    void pressRow(int row, const uint64_t *presses);
+
+    /// @brief Toggles a single light without affecting its neighbours.
+    void toggle(int row, int col);
+
+    /// @brief Turns every light off.
+    void clear();
+
+    /// @brief XORs another board of the same size into this one.
+    Board &operator^=(const Board &other);
+
+    bool operator==(const Board &other) const;
+    bool operator!=(const Board &other) const;
+
+    // --------------------------------------------------------
+    // Getters
+    // --------------------------------------------------------
+    bool isLit(int row, int col) const;
+    bool isSolved() const;
+    int getLitCount() const;
+    int getRows() const;
+    int getCols() const;
+    int getCellCount() const;
+    int getWordsPerRow() const;
+
+    /// @brief Returns the packed words of a row.
+    const uint64_t *getRow(int row) const;
+
+    /// @brief Returns the mask of valid column bits in the last word of each row.
+    uint64_t getLastWordMask() const;
+
+    // --------------------------------------------------------
+    // Setters
+    // --------------------------------------------------------
+
+    /// @brief Replaces the packed words of a row (bits past the last column are ignored).
+    void setRow(int row, const uint64_t *words);
+
+private:
+    /// @brief The dimensions of the board.
+    int rows, cols;
+
+    /// @brief The number of 64-bit words used by each row.
+    int wordsPerRow;
+
+    /// @brief Mask of valid column bits in the last word of each row.
+    uint64_t lastWordMask;
+
+    /// @brief rows * wordsPerRow words, row-major.
+    std::vector<uint64_t> words;
+
+    /// @brief The number of lights currently on.
+    int litCount;
+
+    /// @brief XORs a mask into a single word, keeping litCount up to date.
+    void flip(int row, int word, uint64_t mask);
+};
+
+#endif //GRAPHICS_BOARD_H
@@ -0,0 +1,213 @@
+#include "distanceTable.h"
+#include "bits.h"
+#include "solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+/// @brief The header at the start of a table file.
+struct DistanceTableHeader {
+    char magic[4];
+    uint32_t rows, cols;
+    uint32_t maxDistance;
+    uint32_t entryBits;
+};
+
+static const char TABLE_MAGIC[4] = {'L', 'O', 'D', '2'};
+
+bool DistanceTable::supports(int rows, int cols) {
+    return rows > 0 && cols > 0 && rows * cols <= MAX_CELLS;
+}
+
+DistanceTable::DistanceTable(int rows, int cols) : rows(rows), cols(cols) {
+    if (!supports(rows, cols)) {
+        throw std::invalid_argument("DistanceTable: board has too many cells");
+    }
+    // Use the board's own press and quiet pattern definitions, packed into state bits
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            Board pressed(rows, cols);
+            pressed.press(i, j);
+            toggleMasks.push_back(encode(pressed));
+        }
+    }
+    Solver solver(rows, cols);
+    for (const Board &pattern : solver.getQuietPatterns())
+        quietPatterns.push_back(encode(pattern));
+}
+
+DistanceTable DistanceTable::build(int rows, int cols, unsigned int threads) {
+    DistanceTable table(rows, cols);
+    size_t states = size_t(1) << (rows * cols);
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    table.owned.assign((states + 1) / 2, 0);
+    std::vector<std::atomic<uint64_t>> visited((states + 63) / 64);
+    for (std::atomic<uint64_t> &word : visited)
+        word.store(0, std::memory_order_relaxed);
+    visited[0].store(1, std::memory_order_relaxed);
+
+    // Level by level: each thread expands a slice of the frontier and claims unvisited neighbours with an atomic OR,
+    // so every state lands in exactly one next frontier.
+    std::vector<uint32_t> frontier{0};
+    int distance = 0;
+    while (!frontier.empty()) {
+        distance++;
+        std::vector<std::vector<uint32_t>> found(threads);
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                size_t begin = frontier.size() * t / threads, end = frontier.size() * (t + 1) / threads;
+                for (size_t i = begin; i < end; i++) {
+                    for (uint32_t mask : table.toggleMasks) {
+                        uint32_t next = frontier[i] ^ mask;
+                        uint64_t bit = uint64_t(1) << (next % 64);
+                        if (visited[next / 64].load(std::memory_order_relaxed) & bit)
+                            continue;
+                        if (!(visited[next / 64].fetch_or(bit, std::memory_order_relaxed) & bit))
+                            found[t].push_back(next);
+                    }
+                }
+            });
+        }
+        for (std::thread &worker : workers)
+            worker.join();
+
+        frontier.clear();
+        for (const std::vector<uint32_t> &part : found)
+            frontier.insert(frontier.end(), part.begin(), part.end());
+        if (frontier.empty())
+            break;
+        if (distance > 15 && table.entryBits == 4)
+            table.widen();
+        if (table.entryBits == 8) {
+            for (uint32_t state : frontier)
+                table.owned[state] = static_cast<uint8_t>(distance);
+        } else {
+            for (uint32_t state : frontier)
+                table.owned[state / 2] |= static_cast<uint8_t>(distance << (4 * (state % 2)));
+        }
+        table.maxDistance = distance;
+    }
+
+    table.entries = table.owned.data();
+    return table;
+}
+
+void DistanceTable::widen() {
+    // At most MAX_CELLS presses are ever needed, so a byte always fits
+    size_t states = size_t(1) << (rows * cols);
+    std::vector<uint8_t> bytes(states);
+    for (size_t state = 0; state < states; state++)
+        bytes[state] = (owned[state / 2] >> (4 * (state % 2))) & 0xF;
+    owned = std::move(bytes);
+    entryBits = 8;
+}
+
+size_t DistanceTable::entryBytes() const {
+    size_t states = size_t(1) << (rows * cols);
+    return entryBits == 8 ? states : (states + 1) / 2;
+}
+
+DistanceTable DistanceTable::open(const std::string &path, int rows, int cols) {
+    DistanceTable table(rows, cols);
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(DistanceTableHeader))
+        return table;
+
+    DistanceTableHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0 ||
+        header.rows != static_cast<uint32_t>(rows) || header.cols != static_cast<uint32_t>(cols) ||
+        (header.entryBits != 4 && header.entryBits != 8))
+        return table;
+    table.entryBits = static_cast<int>(header.entryBits);
+    if (file.size() != sizeof(DistanceTableHeader) + table.entryBytes())
+        return table;
+
+    table.maxDistance = static_cast<int>(header.maxDistance);
+    table.mapped = std::move(file);
+    table.entries = table.mapped.data() + sizeof(DistanceTableHeader);
+    return table;
+}
+
+bool DistanceTable::save(const std::string &path) const {
+    if (!isLoaded())
+        return false;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    DistanceTableHeader header{};
+    std::memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    header.rows = rows;
+    header.cols = cols;
+    header.maxDistance = maxDistance;
+    header.entryBits = entryBits;
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries), static_cast<std::streamsize>(entryBytes()));
+    return static_cast<bool>(out);
+}
+
+bool DistanceTable::isLoaded() const {
+    return entries != nullptr;
+}
+
+bool DistanceTable::isSolvable(uint32_t state) const {
+    for (uint32_t pattern : quietPatterns) {
+        if (parity64(state & pattern))
+            return false;
+    }
+    return true;
+}
+
+int DistanceTable::distance(uint32_t state) const {
+    if (!isSolvable(state))
+        return -1;
+    if (entryBits == 8)
+        return entries[state];
+    return (entries[state / 2] >> (4 * (state % 2))) & 0xF;
+}
+
+int DistanceTable::distance(const Board &board) const {
+    return distance(encode(board));
+}
+
+int DistanceTable::hint(const Board &board) const {
+    uint32_t state = encode(board);
+    int current = distance(state);
+    if (current <= 0)
+        return -1;
+    for (size_t cell = 0; cell < toggleMasks.size(); cell++) {
+        if (distance(state ^ toggleMasks[cell]) == current - 1)
+            return static_cast<int>(cell);
+    }
+    return -1;
+}
+
+bool DistanceTable::solve(const Board &board, Board &presses) const {
+    presses = Board(rows, cols);
+    if (distance(board) < 0)
+        return false;
+
+    // Each hint is one step closer, so the presses taken add up to the distance
+    Board lights = board;
+    for (int cell = hint(lights); cell >= 0; cell = hint(lights)) {
+        lights.press(cell / cols, cell % cols);
+        presses.toggle(cell / cols, cell % cols);
+    }
+    return true;
+}
+
+int DistanceTable::getMaxDistance() const {
+    return maxDistance;
+}
+
+uint32_t DistanceTable::encode(const Board &board) {
+    uint32_t state = 0;
+    for (int r = 0; r < board.getRows(); r++)
+        state |= static_cast<uint32_t>(board.getRow(r)[0]) << (r * board.getCols());
+    return state;
+}
@@ -0,0 +1,95 @@
+#ifndef GRAPHICS_DISTANCETABLE_H
+#define GRAPHICS_DISTANCETABLE_H
+
+#include "board.h"
+#include "../util/mappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The optimal number of presses from every state of a small board to solved.
+ * @details The table is indexed by the board packed into an integer (bit row * cols + col) and stores one 4-bit
+ * distance per state, so the 2^25 states of the 5x5 board take 16 MB. Boards whose distances go past 15 (e.g. 4x5 and
+ * 3x7) store one byte per state instead. It is built once by a breadth-first search from
+ * the solved state, saved to a file and memory-mapped on later launches, so looking up a distance, par or hint is O(1)
+ * and never runs a solver.
+ */
+class DistanceTable {
+public:
+    /// @brief The largest board (in cells) a table can be built for.
+    static constexpr int MAX_CELLS = 25;
+
+    /// @brief Returns true if a table can be built for the given board size.
+    static bool supports(int rows, int cols);
+
+    /// @brief Builds the table with a parallel frontier BFS.
+    /// @param threads The number of threads to use (0 uses every hardware thread)
+    static DistanceTable build(int rows, int cols, unsigned int threads = 0);
+
+    /// @brief Memory-maps a table written by save(). Check isLoaded() to see whether it worked.
+    static DistanceTable open(const std::string &path, int rows, int cols);
+
+    /// @brief Writes the table to a file.
+    /// @return true if the file was written
+    bool save(const std::string &path) const;
+
+    /// @brief Returns true if the table holds data for its board size.
+    bool isLoaded() const;
+
+    /// @brief Returns the fewest presses that solve a board, or -1 if it cannot be solved.
+    int distance(const Board &board) const;
+    int distance(uint32_t state) const;
+
+    /// @brief Returns a cell (row * cols + col) whose press brings the board one step closer to solved,
+    /// or -1 if the board is solved or cannot be solved.
+    int hint(const Board &board) const;
+
+    /// @brief Returns a solution with the fewest presses, found by following hint() down to solved.
+    /// @param presses Set to the cells to press (one bit per cell) if the board can be solved
+    /// @return false if the board cannot be solved
+    bool solve(const Board &board, Board &presses) const;
+
+    /// @brief Returns the largest distance in the table.
+    int getMaxDistance() const;
+
+    /// @brief Packs a board into a state index (bit row * cols + col).
+    static uint32_t encode(const Board &board);
+
+private:
+    DistanceTable(int rows, int cols);
+
+    int rows, cols;
+
+    int maxDistance = 0;
+
+    /// @brief The lights toggled by a press on each cell, as state bits.
+    std::vector<uint32_t> toggleMasks;
+
+    /// @brief The quiet patterns as state bits. A state is solvable if it has even overlap with each of them.
+    std::vector<uint32_t> quietPatterns;
+
+    /// @brief The distances, entryBits per state: two per byte (low nibble for even states), or one per byte.
+    /// Points into owned or mapped.
+    const uint8_t *entries = nullptr;
+
+    /// @brief 4, or 8 when some distance does not fit in a nibble.
+    int entryBits = 4;
+
+    /// @brief The size of the distances in bytes.
+    size_t entryBytes() const;
+
+    /// @brief Switches the table being built from nibbles to bytes, keeping the distances found so far.
+    void widen();
+
+    /// @brief The table when it was built in memory.
+    std::vector<uint8_t> owned;
+
+    /// @brief The table when it was loaded from a file.
+    MappedFile mapped;
+
+    bool isSolvable(uint32_t state) const;
+};
+
+#endif //GRAPHICS_DISTANCETABLE_H
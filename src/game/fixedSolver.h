@@ -0,0 +1,167 @@
+#ifndef GRAPHICS_FIXEDSOLVER_H
+#define GRAPHICS_FIXEDSOLVER_H
+
+#include "board.h"
+#include "bits.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief A Lights Out board whose size is known at compile time.
+ * @details All N * M lights fit in one 64-bit word (bit row * M + col), and the toggle mask of every cell is computed
+ * by constexpr evaluation, so a press is a single XOR with a constant.
+ */
+template<int N, int M>
+class FixedBoard {
+    static_assert(N > 0 && M > 0 && N * M <= 64, "FixedBoard: the board must fit in 64 bits");
+
+public:
+    static constexpr int CELLS = N * M;
+
+    /// @brief The lights toggled by a press on each cell: the cell itself and its orthogonal neighbours.
+    static constexpr std::array<uint64_t, CELLS> toggleMasks() {
+        std::array<uint64_t, CELLS> masks{};
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < M; j++) {
+                uint64_t mask = bit(i, j);
+                if (j + 1 < M)  mask |= bit(i, j + 1);
+                if (j - 1 >= 0) mask |= bit(i, j - 1);
+                if (i + 1 < N)  mask |= bit(i + 1, j);
+                if (i - 1 >= 0) mask |= bit(i - 1, j);
+                masks[i * M + j] = mask;
+            }
+        }
+        return masks;
+    }
+
+    static constexpr std::array<uint64_t, CELLS> MASKS = toggleMasks();
+
+    constexpr FixedBoard(uint64_t lights = 0) : lights(lights) {}
+
+    constexpr void press(int row, int col) { lights ^= MASKS[row * M + col]; }
+    constexpr void toggle(int row, int col) { lights ^= bit(row, col); }
+    constexpr bool isLit(int row, int col) const { return (lights >> (row * M + col)) & 1; }
+    constexpr bool isSolved() const { return lights == 0; }
+    constexpr uint64_t getLights() const { return lights; }
+
+    /// @brief Converts a runtime Board of the same size.
+    static FixedBoard fromBoard(const Board &board) {
+        uint64_t lights = 0;
+        for (int r = 0; r < N; r++)
+            lights |= board.getRow(r)[0] << (r * M);
+        return FixedBoard(lights);
+    }
+
+    /// @brief Converts to a runtime Board.
+    Board toBoard() const {
+        Board board(N, M);
+        for (int r = 0; r < N; r++) {
+            uint64_t row = M == 64 ? lights : (lights >> (r * M)) & ((uint64_t(1) << M) - 1);
+            board.setRow(r, &row);
+        }
+        return board;
+    }
+
+private:
+    uint64_t lights;
+
+    static constexpr uint64_t bit(int row, int col) { return uint64_t(1) << (row * M + col); }
+};
+
+/**
+ * @brief Solves N x M boards with a solve matrix computed at compile time.
+ * @details The press matrix is reduced over GF(2) by constexpr evaluation, recording the row operations. For a
+ * solvable board b the presses are then x = P b, where row i of P is the recorded operations of the row whose pivot is
+ * cell i (zero for cells without a pivot). So a solve is N * M AND + popcount-parity operations, with no elimination at
+ * runtime. The recorded rows without a pivot give the solvability check: b is solvable if it has even overlap with
+ * each of them.
+ */
+template<int N, int M>
+class FixedSolver {
+public:
+    static constexpr int CELLS = N * M;
+
+    /// @brief The compile-time solve data.
+    struct Matrix {
+        /// @brief Row i gives press i: x_i = parity(solve[i] & b).
+        std::array<uint64_t, CELLS> solve{};
+
+        /// @brief A board b is solvable if parity(checks[k] & b) is 0 for every k < nullity.
+        std::array<uint64_t, CELLS> checks{};
+
+        int nullity = 0;
+    };
+
+    /// @brief Reduces [A | I] to reduced row echelon form, where A is the (symmetric) press matrix.
+    static constexpr Matrix reduce() {
+        std::array<uint64_t, CELLS> a = FixedBoard<N, M>::MASKS;
+        std::array<uint64_t, CELLS> ops{};
+        for (int i = 0; i < CELLS; i++)
+            ops[i] = uint64_t(1) << i;
+
+        std::array<int, CELLS> pivotOf{};
+        int rank = 0;
+        for (int col = 0; col < CELLS; col++) {
+            uint64_t bit = uint64_t(1) << col;
+            int found = -1;
+            for (int r = rank; r < CELLS && found < 0; r++) {
+                if (a[r] & bit)
+                    found = r;
+            }
+            if (found < 0)
+                continue;
+            uint64_t swapA = a[rank], swapOps = ops[rank];
+            a[rank] = a[found];
+            ops[rank] = ops[found];
+            a[found] = swapA;
+            ops[found] = swapOps;
+            for (int r = 0; r < CELLS; r++) {
+                if (r != rank && (a[r] & bit)) {
+                    a[r] ^= a[rank];
+                    ops[r] ^= ops[rank];
+                }
+            }
+            pivotOf[rank] = col;
+            rank++;
+        }
+
+        Matrix matrix{};
+        for (int r = 0; r < rank; r++)
+            matrix.solve[pivotOf[r]] = ops[r];
+        for (int r = rank; r < CELLS; r++)
+            matrix.checks[r - rank] = ops[r];
+        matrix.nullity = CELLS - rank;
+        return matrix;
+    }
+
+    static constexpr Matrix MATRIX = reduce();
+
+    /// @brief Returns true if some set of presses solves the board.
+    static bool isSolvable(FixedBoard<N, M> board) {
+        uint64_t lights = board.getLights();
+        for (int k = 0; k < MATRIX.nullity; k++) {
+            if (parity64(MATRIX.checks[k] & lights))
+                return false;
+        }
+        return true;
+    }
+
+    /// @brief Finds a set of presses that solves the board.
+    /// @param board The board to solve
+    /// @param presses Set to the cells to press (one bit per cell) if the board is solvable
+    /// @return true if the board is solvable
+    static bool solve(FixedBoard<N, M> board, uint64_t &presses) {
+        if (!isSolvable(board))
+            return false;
+        uint64_t lights = board.getLights(), result = 0;
+        for (int i = 0; i < CELLS; i++)
+            result |= static_cast<uint64_t>(parity64(MATRIX.solve[i] & lights)) << i;
+        presses = result;
+        return true;
+    }
+
+    static constexpr int getNullity() { return MATRIX.nullity; }
+};
+
+#endif //GRAPHICS_FIXEDSOLVER_H
@@ -0,0 +1,35 @@
+#include "generator.h"
+
+#include <chrono>
+#include <vector>
+
+Generator::Generator() {
+    // Mix the clock in with random_device: on some platforms random_device is deterministic
+    std::random_device device;
+    uint64_t now = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    std::seed_seq seed{device(), device(), static_cast<unsigned int>(now), static_cast<unsigned int>(now >> 32)};
+    rng.seed(seed);
+}
+
+Generator::Generator(uint64_t seed) : rng(seed) {}
+
+Board Generator::generate(int rows, int cols) {
+    Board board(rows, cols);
+
+    // Press a random subset of every row, a word at a time
+    std::vector<uint64_t> presses(board.getWordsPerRow());
+    for (int r = 0; r < rows; r++) {
+        for (uint64_t &word : presses)
+            word = rng();
+        board.pressRow(r, presses.data());
+    }
+
+    // The presses can cancel out (with probability 2^-rank). One more press always lights something.
+    if (board.isSolved())
+        board.press(static_cast<int>(rng() % rows), static_cast<int>(rng() % cols));
+    return board;
+}
+
+uint64_t Generator::next() {
+    return rng();
+}
@@ -0,0 +1,34 @@
+#ifndef GRAPHICS_GENERATOR_H
+#define GRAPHICS_GENERATOR_H
+
+#include "board.h"
+
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief Generates random solvable puzzles of any size.
+ * @details A puzzle is built by pressing a random half of the cells on an empty board, so it is solvable by
+ * construction (pressing the same cells again solves it) and no solvability check or retry loop is needed. Because
+ * every subset of presses is equally likely and presses combine linearly, every solvable board is equally likely.
+ * Generation costs one pressRow() per row, whatever the board size.
+ */
+class Generator {
+public:
+    /// @brief Construct a Generator seeded from std::random_device and the high resolution clock.
+    Generator();
+
+    /// @brief Construct a Generator with a fixed seed (e.g. for reproducible simulations).
+    explicit Generator(uint64_t seed);
+
+    /// @brief Returns a random solvable rows x cols board with at least one light on.
+    Board generate(int rows, int cols);
+
+    /// @brief Returns the next 64 random bits.
+    uint64_t next();
+
+private:
+    std::mt19937_64 rng;
+};
+
+#endif //GRAPHICS_GENERATOR_H
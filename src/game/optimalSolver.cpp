@@ -0,0 +1,75 @@
+#include "optimalSolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/// @brief Searches every combination of the first `bits` quiet patterns, starting from `start`, in Gray-code order.
+static void searchGray(Board start, const std::vector<Board> &patterns, int bits, Board &best) {
+    best = start;
+    uint64_t combinations = uint64_t(1) << bits;
+    for (uint64_t i = 1; i < combinations; i++) {
+        // The Gray code of i differs from that of i - 1 in the lowest set bit of i
+        int changed = 0;
+        while (!((i >> changed) & 1))
+            changed++;
+        start ^= patterns[changed];
+        if (start.getLitCount() < best.getLitCount())
+            best = start;
+    }
+}
+
+OptimalSolver::OptimalSolver(int rows, int cols, int maxNullity)
+        : solver(rows, cols), maxNullity(std::min(maxNullity, 62)) {}
+
+bool OptimalSolver::solve(const Board &board, OptimalSolution &result, unsigned int threads) const {
+    auto start = std::chrono::steady_clock::now();
+
+    Board particular(board.getRows(), board.getCols());
+    if (!solver.solve(board, particular))
+        return false;
+
+    const std::vector<Board> &patterns = solver.getQuietPatterns();
+    int nullity = std::min(static_cast<int>(patterns.size()), maxNullity);
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    Board best = particular;
+    if (nullity < PARALLEL_NULLITY || threads == 1) {
+        searchGray(particular, patterns, nullity, best);
+    } else {
+        // Fix the top `split` patterns differently on each task and enumerate the rest on it
+        int split = 0;
+        while ((1u << (split + 1)) <= threads && split + 1 < nullity - PARALLEL_NULLITY / 2)
+            split++;
+        int low = nullity - split;
+
+        std::vector<Board> bests(size_t(1) << split, particular);
+        std::vector<std::thread> workers;
+        for (size_t prefix = 0; prefix < bests.size(); prefix++) {
+            Board first = particular;
+            for (int b = 0; b < split; b++) {
+                if ((prefix >> b) & 1)
+                    first ^= patterns[low + b];
+            }
+            workers.emplace_back(searchGray, first, std::cref(patterns), low, std::ref(bests[prefix]));
+        }
+        for (std::thread &worker : workers)
+            worker.join();
+        for (const Board &candidate : bests) {
+            if (candidate.getLitCount() < best.getLitCount())
+                best = candidate;
+        }
+    }
+
+    result.presses = best;
+    result.pressCount = best.getLitCount();
+    result.optimal = nullity == static_cast<int>(patterns.size());
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+const Solver &OptimalSolver::getSolver() const {
+    return solver;
+}
@@ -0,0 +1,54 @@
+#ifndef GRAPHICS_OPTIMALSOLVER_H
+#define GRAPHICS_OPTIMALSOLVER_H
+
+#include "solver.h"
+
+/**
+ * @brief The result of OptimalSolver::solve().
+ */
+struct OptimalSolution {
+    /// @brief The cells to press (one bit per cell).
+    Board presses;
+
+    /// @brief The number of presses in the solution.
+    int pressCount = 0;
+
+    /// @brief true if every combination of quiet patterns was checked, so pressCount is the minimum.
+    bool optimal = false;
+
+    /// @brief Wall-clock time the search took, in seconds.
+    double seconds = 0;
+};
+
+/**
+ * @brief Finds the solution with the fewest presses.
+ * @details Every solution is one particular solution XORed with a combination of the quiet patterns, so with
+ * nullity k there are 2^k solutions. They are enumerated in Gray-code order, so each step XORs in a single quiet
+ * pattern and re-counts the presses with popcount. With a large nullity the enumeration is split across threads.
+ */
+class OptimalSolver {
+public:
+    /// @brief Construct an OptimalSolver for rows x cols boards.
+    /// @param maxNullity Only the first maxNullity quiet patterns are enumerated (2^maxNullity combinations)
+    OptimalSolver(int rows, int cols, int maxNullity = 30);
+
+    /// @brief Finds the solution of a board with the fewest presses.
+    /// @param board The board to solve
+    /// @param result Set to the best solution found if the board is solvable
+    /// @param threads The number of threads to split the search over (0 uses every hardware thread)
+    /// @return true if the board is solvable
+    bool solve(const Board &board, OptimalSolution &result, unsigned int threads = 0) const;
+
+    /// @brief Returns the underlying solver.
+    const Solver &getSolver() const;
+
+private:
+    Solver solver;
+
+    int maxNullity;
+
+    /// @brief Enumerations smaller than this run on the calling thread.
+    static constexpr int PARALLEL_NULLITY = 14;
+};
+
+#endif //GRAPHICS_OPTIMALSOLVER_H
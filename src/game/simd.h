@@ -0,0 +1,46 @@
+#ifndef GRAPHICS_SIMD_H
+#define GRAPHICS_SIMD_H
+
+// Which SIMD kernels can be compiled, and how to check for them at runtime.
+//
+// GCC/Clang on x86: every kernel is compiled (marked with SIMD_TARGET) and one is picked at runtime from the CPU
+// features. MSVC on x64: SSE2 is always available, AVX2 only when compiled with /arch:AVX2. Anywhere else only the
+// portable scalar kernels are used.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86_DISPATCH
+#define SIMD_TARGET(name) __attribute__((target(name)))
+#define SIMD_HAVE_SSE2
+#define SIMD_HAVE_AVX2
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define SIMD_TARGET(name)
+#define SIMD_HAVE_SSE2
+#if defined(__AVX2__)
+#define SIMD_HAVE_AVX2
+#endif
+#include <immintrin.h>
+#endif
+
+/// @brief Returns true if AVX2 kernels can run on this CPU.
+inline bool cpuHasAvx2() {
+#if defined(SIMD_X86_DISPATCH)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(SIMD_HAVE_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// @brief Returns true if SSE2 kernels can run on this CPU.
+inline bool cpuHasSse2() {
+#if defined(SIMD_HAVE_SSE2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+#endif //GRAPHICS_SIMD_H
@@ -0,0 +1,154 @@
+#include "solver.h"
+#include "bits.h"
+
+#include <algorithm>
+#include <utility>
+
+/// @brief Applies a row of symbolic presses to the rows they affect.
+/// @details Row c of each matrix is the affine form (over the first-row presses) of the light or press in column c.
+static void applyPresses(const BitMatrix &presses, BitMatrix &row, BitMatrix &below) {
+    int width = presses.getRows();
+    for (int c = 0; c < width; c++) {
+        const uint64_t *press = presses.row(c);
+        row.xorRow(c, press);
+        if (c > 0)
+            row.xorRow(c - 1, press);
+        if (c + 1 < width)
+            row.xorRow(c + 1, press);
+        below.xorRow(c, press);
+    }
+}
+
+Solver::Solver(int rows, int cols) : rows(rows), cols(cols) {
+    transposed = cols > rows;
+    width = std::min(rows, cols);
+    int height = std::max(rows, cols);
+
+    // Chase symbolically: start with a press on each cell of the first row, then press under every light that is
+    // still on. What is left in the last row is the chase matrix.
+    BitMatrix presses = BitMatrix::identity(width), current(width, width), below(width, width);
+    applyPresses(presses, current, below);
+    for (int r = 1; r < height; r++) {
+        std::swap(presses, current);
+        std::swap(current, below);
+        below.clear();
+        applyPresses(presses, current, below);
+    }
+
+    // Augment with an identity matrix (starting on a word boundary) to record the row operations
+    int offset = wordsForBits(width) * 64;
+    reduced = BitMatrix(width, offset + width);
+    for (int i = 0; i < width; i++) {
+        std::copy(current.row(i), current.row(i) + wordsForBits(width), reduced.row(i));
+        reduced.set(i, offset + i, true);
+    }
+    pivots = reduced.reduce(width);
+
+    // Each column without a pivot is a free first-row press. Chasing it (with the pivot presses it forces) through
+    // an empty board changes nothing, giving one quiet pattern per free column.
+    std::vector<bool> isPivot(width, false);
+    for (int p : pivots)
+        isPivot[p] = true;
+    for (int free = 0; free < width; free++) {
+        if (isPivot[free])
+            continue;
+        std::vector<uint64_t> firstRow(wordsForBits(width), 0);
+        firstRow[free / 64] |= uint64_t(1) << (free % 64);
+        for (size_t i = 0; i < pivots.size(); i++) {
+            if (reduced.get(static_cast<int>(i), free))
+                firstRow[pivots[i] / 64] |= uint64_t(1) << (pivots[i] % 64);
+        }
+        Board lights(height, width), pattern(height, width);
+        chase(lights, firstRow.data(), &pattern);
+        quietPatterns.push_back(orient(pattern));
+    }
+}
+
+void Solver::chase(Board &lights, const uint64_t *firstRow, Board *presses) const {
+    lights.pressRow(0, firstRow);
+    if (presses)
+        presses->setRow(0, firstRow);
+
+    std::vector<uint64_t> row(lights.getWordsPerRow());
+    for (int r = 1; r < lights.getRows(); r++) {
+        const uint64_t *above = lights.getRow(r - 1);
+        std::copy(above, above + row.size(), row.begin());
+        lights.pressRow(r, row.data());
+        if (presses)
+            presses->setRow(r, row.data());
+    }
+}
+
+bool Solver::solveFirstRow(const uint64_t *residue, std::vector<uint64_t> &firstRow) const {
+    int words = wordsForBits(width);
+    int offset = words;
+    firstRow.assign(words, 0);
+
+    for (int i = 0; i < width; i++) {
+        // Apply row i of the recorded row operations to the residue
+        const uint64_t *ops = reduced.row(i) + offset;
+        uint64_t dot = 0;
+        for (int w = 0; w < words; w++)
+            dot ^= ops[w] & residue[w];
+        if (!parity64(dot))
+            continue;
+
+        // A zero row of the reduced matrix that needs a one means there is no solution
+        if (i >= static_cast<int>(pivots.size()))
+            return false;
+        firstRow[pivots[i] / 64] |= uint64_t(1) << (pivots[i] % 64);
+    }
+    return true;
+}
+
+bool Solver::solve(const Board &board, Board &presses) const {
+    Board start = orient(board);
+
+    // Chase with no first-row presses to find what is left over in the last row
+    Board lights = start;
+    std::vector<uint64_t> none(lights.getWordsPerRow(), 0);
+    chase(lights, none.data(), nullptr);
+
+    std::vector<uint64_t> firstRow;
+    if (!solveFirstRow(lights.getRow(lights.getRows() - 1), firstRow))
+        return false;
+
+    // Chase again, this time starting with the presses that clear the last row
+    Board solution(start.getRows(), start.getCols());
+    chase(start, firstRow.data(), &solution);
+    presses = orient(solution);
+    return true;
+}
+
+bool Solver::isSolvable(const Board &board) const {
+    // A board is solvable exactly when it is orthogonal to every quiet pattern
+    for (const Board &pattern : quietPatterns) {
+        int odd = 0;
+        for (int r = 0; r < rows; r++) {
+            const uint64_t *a = board.getRow(r), *b = pattern.getRow(r);
+            for (int w = 0; w < board.getWordsPerRow(); w++)
+                odd ^= parity64(a[w] & b[w]);
+        }
+        if (odd)
+            return false;
+    }
+    return true;
+}
+
+Board Solver::orient(const Board &board) const {
+    if (!transposed)
+        return board;
+    Board result(board.getCols(), board.getRows());
+    for (int r = 0; r < board.getRows(); r++) {
+        for (int c = 0; c < board.getCols(); c++) {
+            if (board.isLit(r, c))
+                result.toggle(c, r);
+        }
+    }
+    return result;
+}
+
+int Solver::getNullity() const                              { return width - static_cast<int>(pivots.size()); }
+const std::vector<Board> &Solver::getQuietPatterns() const  { return quietPatterns; }
+int Solver::getRows() const                                 { return rows; }
+int Solver::getCols() const                                 { return cols; }
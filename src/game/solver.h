@@ -0,0 +1,72 @@
+#ifndef GRAPHICS_SOLVER_H
+#define GRAPHICS_SOLVER_H
+
+#include "board.h"
+#include "bitMatrix.h"
+
+#include <vector>
+
+/**
+ * @brief Solves Lights Out positions of a fixed size by Gaussian elimination over GF(2).
+ * @details Pressing the lit cells of each row in the row below ("light chasing") clears every row but the last,
+ * and what is left in the last row depends linearly on the presses made in the first row. So instead of reducing the
+ * full (rows * cols)^2 press matrix, the solver builds that cols x cols "chase matrix" once per board size and reduces
+ * it, recording the row operations. A solve is then two chases and one matrix-vector product.
+ * Boards that are wider than they are tall are solved transposed, so the chase matrix is always the smaller side.
+ */
+class Solver {
+public:
+    /// @brief Builds and reduces the chase matrix for a rows x cols board.
+    Solver(int rows, int cols);
+
+    /// @brief Finds a set of presses that turns every light off.
+    /// @param board The board to solve (must be rows x cols)
+    /// @param presses Set to the cells to press (one bit per cell) if the board is solvable
+    /// @return true if the board is solvable
+    bool solve(const Board &board, Board &presses) const;
+
+    /// @brief Returns true if some set of presses turns every light off.
+    bool isSolvable(const Board &board) const;
+
+    /// @brief The number of independent press sets that change nothing (the dimension of the press matrix's kernel).
+    int getNullity() const;
+
+    /// @brief A basis of the press sets that leave every light unchanged ("quiet patterns").
+    /// @details Any solution XORed with a combination of these is another solution.
+    const std::vector<Board> &getQuietPatterns() const;
+
+    int getRows() const;
+    int getCols() const;
+
+private:
+    /// @brief The board dimensions the solver was built for.
+    int rows, cols;
+
+    /// @brief true if the board is solved transposed (it is wider than it is tall).
+    bool transposed;
+
+    /// @brief The size of the chase matrix (the shorter side of the board).
+    int width;
+
+    /// @brief The reduced chase matrix on the left, the row operations that reduced it on the right.
+    BitMatrix reduced;
+
+    /// @brief The pivot column of each of the first rank rows of reduced.
+    std::vector<int> pivots;
+
+    std::vector<Board> quietPatterns;
+
+    /// @brief Chases lights down a board with the given first row of presses.
+    /// @param lights The board to chase on (in solver orientation); left holding only the last row
+    /// @param firstRow The presses to make in the first row
+    /// @param presses If not null, receives every press made
+    void chase(Board &lights, const uint64_t *firstRow, Board *presses) const;
+
+    /// @brief Solves for the first row of presses that clears the given last-row residue.
+    bool solveFirstRow(const uint64_t *residue, std::vector<uint64_t> &firstRow) const;
+
+    /// @brief Converts a board between the caller's orientation and the solver's.
+    Board orient(const Board &board) const;
+};
+
+#endif //GRAPHICS_SOLVER_H
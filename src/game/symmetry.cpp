@@ -0,0 +1,149 @@
+#include "symmetry.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+Symmetry::Symmetry(int size, bool withComplement) : size(size), withComplement(withComplement) {
+    if (size <= 0 || size > MAX_SIZE) {
+        throw std::invalid_argument("Symmetry: board side must be between 1 and 8");
+    }
+    uint64_t row = (uint64_t(1) << size) - 1;
+    fullMask = 0;
+    for (int r = 0; r < size; r++)
+        fullMask |= row << (8 * r);
+}
+
+uint64_t Symmetry::transpose(uint64_t x) {
+    // Delta swaps exchanging 4x4, then 2x2, then 1x1 blocks across the diagonal
+    const uint64_t k1 = 0x5500550055005500ULL;
+    const uint64_t k2 = 0x3333000033330000ULL;
+    const uint64_t k4 = 0x0f0f0f0f00000000ULL;
+    uint64_t t;
+    t = k4 & (x ^ (x << 28));
+    x ^= t ^ (t >> 28);
+    t = k2 & (x ^ (x << 14));
+    x ^= t ^ (t >> 14);
+    t = k1 & (x ^ (x << 7));
+    x ^= t ^ (t >> 7);
+    return x;
+}
+
+uint64_t Symmetry::flipRows(uint64_t x) const {
+    // Reverse the 8 bytes, then move the board from the bottom rows back to the top
+    x = ((x >> 8) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) << 8);
+    x = ((x >> 16) & 0x0000FFFF0000FFFFULL) | ((x & 0x0000FFFF0000FFFFULL) << 16);
+    x = (x >> 32) | (x << 32);
+    return x >> (8 * (MAX_SIZE - size));
+}
+
+uint64_t Symmetry::flipCols(uint64_t x) const {
+    // Reverse the bits of every byte, then move the board from the high columns back to the low ones
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return x >> (MAX_SIZE - size);
+}
+
+void Symmetry::images(uint64_t x, uint64_t out[8]) const {
+    uint64_t rows = flipRows(x), cols = flipCols(x), both = flipCols(rows);
+    out[0] = x;
+    out[1] = rows;
+    out[2] = cols;
+    out[3] = both;
+    out[4] = transpose(x);
+    out[5] = transpose(rows);
+    out[6] = transpose(cols);
+    out[7] = transpose(both);
+}
+
+uint64_t Symmetry::canonical(uint64_t packed) const {
+    uint64_t image[8];
+    images(packed, image);
+    uint64_t best = image[0];
+    for (int i = 1; i < 8; i++)
+        best = std::min(best, image[i]);
+    if (withComplement) {
+        // The complement's images are the complements of the images
+        for (int i = 0; i < 8; i++)
+            best = std::min(best, image[i] ^ fullMask);
+    }
+    return best;
+}
+
+std::vector<uint64_t> Symmetry::orbit(uint64_t packed) const {
+    uint64_t image[8];
+    images(packed, image);
+    std::vector<uint64_t> result(image, image + 8);
+    if (withComplement) {
+        for (int i = 0; i < 8; i++)
+            result.push_back(image[i] ^ fullMask);
+    }
+    return result;
+}
+
+uint64_t Symmetry::pack(const Board &board) const {
+    uint64_t packed = 0;
+    for (int r = 0; r < size; r++)
+        packed |= board.getRow(r)[0] << (8 * r);
+    return packed;
+}
+
+Board Symmetry::unpack(uint64_t packed) const {
+    Board board(size, size);
+    for (int r = 0; r < size; r++) {
+        uint64_t row = (packed >> (8 * r)) & 0xFF;
+        board.setRow(r, &row);
+    }
+    return board;
+}
+
+int Symmetry::getSize() const {
+    return size;
+}
+
+// --------------------------------------------------------
+// SymmetryIndex
+// --------------------------------------------------------
+
+SymmetryIndex::SymmetryIndex(const Symmetry &symmetry) : symmetry(symmetry) {}
+
+void SymmetryIndex::add(uint64_t packed, uint8_t value) {
+    keys.push_back(symmetry.canonical(packed));
+    values.push_back(value);
+}
+
+void SymmetryIndex::finish() {
+    // Sort by key, keeping insertion order for equal keys so the first value wins
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+    std::vector<uint64_t> sortedKeys;
+    std::vector<uint8_t> sortedValues;
+    for (size_t i : order) {
+        if (!sortedKeys.empty() && sortedKeys.back() == keys[i])
+            continue;
+        sortedKeys.push_back(keys[i]);
+        sortedValues.push_back(values[i]);
+    }
+    keys.swap(sortedKeys);
+    values.swap(sortedValues);
+}
+
+long long SymmetryIndex::find(uint64_t packed) const {
+    uint64_t key = symmetry.canonical(packed);
+    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    if (it == keys.end() || *it != key)
+        return -1;
+    return it - keys.begin();
+}
+
+int SymmetryIndex::value(uint64_t packed) const {
+    long long position = find(packed);
+    return position < 0 ? -1 : values[static_cast<size_t>(position)];
+}
+
+size_t SymmetryIndex::size() const {
+    return keys.size();
+}
@@ -0,0 +1,99 @@
+#ifndef GRAPHICS_SYMMETRY_H
+#define GRAPHICS_SYMMETRY_H
+
+#include "board.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Maps square boards to a canonical member of their symmetry orbit.
+ * @details Rotating or reflecting a board (the 8 elements of the dihedral group D4) does not change how hard it is,
+ * so puzzle stores only need one board per orbit. A board of up to 8x8 is packed one row per byte into a 64-bit
+ * word, where every symmetry is a short sequence of branch-free delta swaps and shifts; the canonical form is the
+ * smallest of the 8 images. Optionally the complement (every light flipped) is folded in too, giving 16 images.
+ * Note that complementing does not preserve the number of presses needed, so only use it for stores that do not
+ * depend on distance.
+ */
+class Symmetry {
+public:
+    /// @brief The largest supported board side.
+    static constexpr int MAX_SIZE = 8;
+
+    /// @brief Construct the symmetry group of size x size boards.
+    /// @param withComplement Also treat a board and its complement as equivalent
+    explicit Symmetry(int size = 5, bool withComplement = false);
+
+    /// @brief Returns the smallest packed board in the orbit of a packed board.
+    uint64_t canonical(uint64_t packed) const;
+
+    /// @brief Returns the 8 (or 16, with complements) images of a packed board, some of which may repeat.
+    std::vector<uint64_t> orbit(uint64_t packed) const;
+
+    /// @brief Packs a size x size board one row per byte (bit 8 * row + col).
+    uint64_t pack(const Board &board) const;
+
+    /// @brief Unpacks a packed board.
+    Board unpack(uint64_t packed) const;
+
+    int getSize() const;
+
+    // --------------------------------------------------------
+    // Packed 8x8 transforms
+    // --------------------------------------------------------
+
+    /// @brief Swaps rows and columns (reflects in the main diagonal). A size x size board stays in place.
+    static uint64_t transpose(uint64_t packed);
+
+    /// @brief Reverses the order of the rows of a size x size board.
+    uint64_t flipRows(uint64_t packed) const;
+
+    /// @brief Reverses the order of the columns of a size x size board.
+    uint64_t flipCols(uint64_t packed) const;
+
+private:
+    int size;
+    bool withComplement;
+
+    /// @brief Every cell of a size x size board.
+    uint64_t fullMask;
+
+    /// @brief The 8 images of a packed board under D4.
+    void images(uint64_t packed, uint64_t out[8]) const;
+};
+
+/**
+ * @brief A sorted set of canonical boards with a small value (e.g. a distance or puzzle id) per board.
+ * @details Boards are stored once per symmetry orbit, so the index is about 8x smaller than one keyed on raw boards.
+ * Any member of an orbit finds the stored entry.
+ */
+class SymmetryIndex {
+public:
+    explicit SymmetryIndex(const Symmetry &symmetry);
+
+    /// @brief Adds a board (in any orientation). Call finish() before looking anything up.
+    void add(uint64_t packed, uint8_t value);
+
+    /// @brief Sorts the entries and drops duplicate orbits (keeping the first value added).
+    void finish();
+
+    /// @brief Returns the position of a board's orbit in the index, or -1 if it is not in it.
+    long long find(uint64_t packed) const;
+
+    /// @brief Returns the value stored for a board's orbit, or -1 if it is not in it.
+    int value(uint64_t packed) const;
+
+    size_t size() const;
+
+private:
+    Symmetry symmetry;
+
+    /// @brief Canonical boards in ascending order (after finish()).
+    std::vector<uint64_t> keys;
+
+    /// @brief The value of each key.
+    std::vector<uint8_t> values;
+};
+
+#endif //GRAPHICS_SYMMETRY_H
@@ -0,0 +1,20 @@
+#include "hitTest.h"
+
+HitTest::HitTest(const GridLayout &layout, int rows, int cols, float width, float height)
+        : layout(layout), rows(rows), cols(cols), shapes(width, height) {}
+
+int HitTest::cellAt(vec2 point) const {
+    return layout.cellAt(point, rows, cols);
+}
+
+void HitTest::addShape(const Shape *shape) {
+    shapes.insert(shape);
+}
+
+void HitTest::removeShape(const Shape *shape) {
+    shapes.remove(shape);
+}
+
+const Shape *HitTest::shapeAt(vec2 point) const {
+    return shapes.query(point);
+}
@@ -0,0 +1,36 @@
+#ifndef GRAPHICS_HITTEST_H
+#define GRAPHICS_HITTEST_H
+
+#include "../shapes/spatialIndex.h"
+#include "../util/gridLayout.h"
+
+/**
+ * @brief Finds what is under the cursor.
+ * @details Cells of the light grid are found in constant time from the grid's origin, pitch and gap. Any other
+ * shapes (which are not on the grid) are registered with a uniform-grid SpatialIndex and found through it. Its
+ * buckets are sized for such shapes, not for the grid's cells, and only allocated once a shape is added.
+ */
+class HitTest {
+public:
+    /// @brief Construct a hit tester for a rows x cols grid in a width x height window.
+    HitTest(const GridLayout &layout, int rows, int cols, float width, float height);
+
+    /// @brief Returns the grid cell under a point (row * cols + col), or -1 if there is none.
+    int cellAt(vec2 point) const;
+
+    /// @brief Registers a shape that is not part of the grid.
+    void addShape(const Shape *shape);
+
+    /// @brief Unregisters a shape added with addShape().
+    void removeShape(const Shape *shape);
+
+    /// @brief Returns the topmost registered shape under a point, or nullptr if there is none.
+    const Shape *shapeAt(vec2 point) const;
+
+private:
+    GridLayout layout;
+    int rows, cols;
+    SpatialIndex shapes;
+};
+
+#endif //GRAPHICS_HITTEST_H
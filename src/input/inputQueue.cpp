@@ -0,0 +1,77 @@
+#include "inputQueue.h"
+
+void InputQueue::attach(GLFWwindow *window) {
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, keyCallback);
+    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    // Frames are only drawn when something changed, so the window system asking for a redraw is an event too
+    glfwSetWindowRefreshCallback(window, refreshCallback);
+    glfwSetWindowIconifyCallback(window, iconifyCallback);
+    glfwSetWindowFocusCallback(window, focusCallback);
+    glfwGetCursorPos(window, &cursorX, &cursorY);
+}
+
+bool InputQueue::push(const InputEvent &event) {
+    // Merge cursor moves that have not been handled yet; only the latest position matters
+    if (event.type == InputEvent::CursorPos && count > 0) {
+        InputEvent &last = events[(head + count - 1) % CAPACITY];
+        if (last.type == InputEvent::CursorPos) {
+            last = event;
+            return true;
+        }
+    }
+    if (count == CAPACITY) {
+        dropped++;
+        return false;
+    }
+    events[(head + count) % CAPACITY] = event;
+    count++;
+    return true;
+}
+
+bool InputQueue::pop(InputEvent &event) {
+    if (count == 0)
+        return false;
+    event = events[head];
+    head = (head + 1) % CAPACITY;
+    count--;
+    return true;
+}
+
+bool InputQueue::isEmpty() const    { return count == 0; }
+size_t InputQueue::size() const     { return count; }
+size_t InputQueue::getDropped() const { return dropped; }
+
+void InputQueue::keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods) {
+    auto *queue = static_cast<InputQueue *>(glfwGetWindowUserPointer(window));
+    queue->push(InputEvent{InputEvent::Key, key, action, queue->cursorX, queue->cursorY, glfwGetTime()});
+}
+
+void InputQueue::mouseButtonCallback(GLFWwindow *window, int button, int action, int mods) {
+    auto *queue = static_cast<InputQueue *>(glfwGetWindowUserPointer(window));
+    queue->push(InputEvent{InputEvent::MouseButton, button, action, queue->cursorX, queue->cursorY, glfwGetTime()});
+}
+
+void InputQueue::cursorPosCallback(GLFWwindow *window, double x, double y) {
+    auto *queue = static_cast<InputQueue *>(glfwGetWindowUserPointer(window));
+    queue->cursorX = x;
+    queue->cursorY = y;
+    queue->push(InputEvent{InputEvent::CursorPos, 0, 0, x, y, glfwGetTime()});
+}
+
+void InputQueue::refreshCallback(GLFWwindow *window) {
+    auto *queue = static_cast<InputQueue *>(glfwGetWindowUserPointer(window));
+    queue->push(InputEvent{InputEvent::Refresh, 0, 0, queue->cursorX, queue->cursorY, glfwGetTime()});
+}
+
+void InputQueue::iconifyCallback(GLFWwindow *window, int iconified) {
+    // Restored windows may not get a refresh callback on every platform
+    if (!iconified)
+        refreshCallback(window);
+}
+
+void InputQueue::focusCallback(GLFWwindow *window, int focused) {
+    if (focused)
+        refreshCallback(window);
+}
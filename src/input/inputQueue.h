@@ -0,0 +1,78 @@
+#ifndef GRAPHICS_INPUTQUEUE_H
+#define GRAPHICS_INPUTQUEUE_H
+
+#include <array>
+#include <cstddef>
+#include <GLFW/glfw3.h>
+
+/**
+ * @brief A single input event received from GLFW.
+ */
+struct InputEvent {
+    /// @brief Refresh: the window's contents were lost (exposed, restored or refocused) and must be redrawn.
+    enum Type { Key, MouseButton, CursorPos, Refresh };
+
+    Type type;
+
+    /// @brief GLFW_KEY_{key} for Key events, GLFW_MOUSE_BUTTON_{button} for MouseButton events.
+    int code;
+
+    /// @brief GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT (unused for CursorPos and Refresh events).
+    int action;
+
+    /// @brief Cursor position when the event happened, in window coordinates (origin at the top left).
+    double x, y;
+
+    /// @brief glfwGetTime() when the event was received.
+    double time;
+};
+
+/**
+ * @brief Fixed-capacity ring buffer of input events, filled by GLFW callbacks.
+ * @details The game loop drains the queue once per frame and only acts on the events in it, instead of polling every
+ * key. Because presses and releases are queued separately, a click whose press and release both land between two
+ * frames is not lost. Consecutive cursor moves are merged into one event, so moving the mouse cannot fill the queue.
+ */
+class InputQueue {
+public:
+    /// @brief The number of events the queue can hold. Events arriving when it is full are dropped.
+    static constexpr size_t CAPACITY = 256;
+
+    /// @brief Installs the key, mouse button, cursor, refresh, iconify and focus callbacks on a window.
+    /// @details Uses the window's user pointer to find the queue.
+    void attach(GLFWwindow *window);
+
+    /// @brief Adds an event to the back of the queue.
+    /// @return false if the queue was full and the event was dropped
+    bool push(const InputEvent &event);
+
+    /// @brief Removes the event at the front of the queue.
+    /// @return false if the queue was empty
+    bool pop(InputEvent &event);
+
+    bool isEmpty() const;
+    size_t size() const;
+
+    /// @brief The number of events dropped because the queue was full.
+    size_t getDropped() const;
+
+private:
+    std::array<InputEvent, CAPACITY> events;
+
+    /// @brief Index of the front event, and the number of events queued.
+    size_t head = 0, count = 0;
+
+    size_t dropped = 0;
+
+    /// @brief The last cursor position seen, stamped on key and button events.
+    double cursorX = 0, cursorY = 0;
+
+    static void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
+    static void mouseButtonCallback(GLFWwindow *window, int button, int action, int mods);
+    static void cursorPosCallback(GLFWwindow *window, double x, double y);
+    static void refreshCallback(GLFWwindow *window);
+    static void iconifyCallback(GLFWwindow *window, int iconified);
+    static void focusCallback(GLFWwindow *window, int focused);
+};
+
+#endif //GRAPHICS_INPUTQUEUE_H
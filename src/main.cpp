@@ -1,18 +1,62 @@
 
 #include "engine.h"
+#include "util/resourcePack.h"
 
+#include <cstdlib>
 #include <iostream>
 
 
 int main(int argc, char *argv[]) {
-    Engine engine;
+    // Resources are found next to the executable, whatever the working directory
+    ResourcePack::setExecutablePath(argv[0]);
 
-    while (!engine.shouldClose()) {
-        engine.processInput();
-        engine.update();
-        engine.render();
+    // Optional board size and flags: Lights_Out [rows] [cols] [--swap=...] [--gpu-sync=...] [--late-input] [--continuous]
+    // [--autoplay]
+    LatencyMode latency;
+    bool autoplay = false;
+    int size[2] = {5, 0}, sizes = 0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--autoplay") {
+            autoplay = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            if (!latency.parse(arg)) {
+                std::cout << "Unknown option " << arg << std::endl;
+                return 1;
+            }
+        } else if (sizes < 2) {
+            size[sizes++] = std::atoi(argv[i]);
+        }
     }
+    int rows = size[0];
+    int cols = sizes > 1 ? size[1] : rows;
+    if (rows < 3 || cols < 3 || rows > Engine::MAX_BOARD_SIZE || cols > Engine::MAX_BOARD_SIZE) {
+        std::cout << "Board size must be between 3 and " << Engine::MAX_BOARD_SIZE << std::endl;
+        return 1;
+    }
+
+    size_t allocatingFrames;
+    {
+        Engine engine(rows, cols, latency);
+        engine.setAutoplay(autoplay);
+
+        while (!engine.shouldClose()) {
+            engine.beginFrame();
+            engine.processInput();
+            engine.update();
+            engine.render();
+        }
 
+        engine.printReport();
+        allocatingFrames = engine.getAllocatingFrames();
+    }
+    // Only once the engine, and every GL object it owns (fence, buffers, shaders), is gone with the context current
     glfwTerminate();
+
+    // Builds counting allocations double as a check that steady-state frames never allocate
+    if (allocatingFrames > 0) {
+        std::cout << "ERROR::ENGINE: Frames allocated after the first" << std::endl;
+        return 1;
+    }
     return 0;
 }
@@ -6,24 +6,30 @@ Shader &Shader::use() {
 }
 
 void Shader::compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource) {
+    // a negative length tells the driver the source is null-terminated
+    compile(vertexSource, -1, fragmentSource, -1, geometrySource, -1);
+}
+
+void Shader::compile(const char *vertexSource, int vertexLength, const char *fragmentSource, int fragmentLength,
+                     const char *geometrySource, int geometryLength) {
     unsigned int sVertex, sFragment, gShader;
 
     // vertex Shader
     sVertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(sVertex, 1, &vertexSource, NULL);
+    glShaderSource(sVertex, 1, &vertexSource, &vertexLength);
     glCompileShader(sVertex);
     checkCompileErrors(sVertex, "VERTEX");
 
     // fragment Shader
     sFragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(sFragment, 1, &fragmentSource, NULL);
+    glShaderSource(sFragment, 1, &fragmentSource, &fragmentLength);
     glCompileShader(sFragment);
     checkCompileErrors(sFragment, "FRAGMENT");
 
     // if geometry shader source code is given, also compile geometry shader
     if (geometrySource != nullptr) {
         gShader = glCreateShader(GL_GEOMETRY_SHADER);
-        glShaderSource(gShader, 1, &geometrySource, NULL);
+        glShaderSource(gShader, 1, &geometrySource, &geometryLength);
         glCompileShader(gShader);
         checkCompileErrors(gShader, "GEOMETRY");
     }
@@ -34,6 +40,9 @@ void Shader::compile(const char* vertexSource, const char* fragmentSource, const
     glAttachShader(this->ID, sFragment);
     if (geometrySource != nullptr)
         glAttachShader(this->ID, gShader);
+    // let the driver know the binary will be retrieved, so it keeps it
+    if (supportsBinaries())
+        glProgramParameteri(this->ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
     glLinkProgram(this->ID);
     checkCompileErrors(this->ID, "PROGRAM");
@@ -43,43 +52,147 @@ void Shader::compile(const char* vertexSource, const char* fragmentSource, const
     glDeleteShader(sFragment);
     if (geometrySource != nullptr)
         glDeleteShader(gShader);
+
+    reflectUniforms();
+}
+
+bool Shader::supportsBinaries() {
+    static const bool supported = [] {
+        if (glGetProgramBinary == nullptr || glProgramBinary == nullptr || glProgramParameteri == nullptr)
+            return false;
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        return formats > 0;
+    }();
+    return supported;
+}
+
+bool Shader::loadBinary(unsigned int format, const void *binary, int length) {
+    if (!supportsBinaries())
+        return false;
+
+    this->ID = glCreateProgram();
+    glProgramBinary(this->ID, format, binary, length);
+    GLint success = 0;
+    glGetProgramiv(this->ID, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(this->ID);
+        this->ID = 0;
+        return false;
+    }
+
+    reflectUniforms();
+    return true;
+}
+
+bool Shader::getBinary(std::vector<unsigned char> &binary, unsigned int &format) const {
+    if (!supportsBinaries())
+        return false;
+
+    GLint length = 0;
+    glGetProgramiv(this->ID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+    binary.resize(length);
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(this->ID, length, &length, &binaryFormat, binary.data());
+    binary.resize(length);
+    format = binaryFormat;
+    return length > 0;
+}
+
+void Shader::reflectUniforms() {
+    uniformLocations.clear();
+
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    string name(maxLength > 0 ? maxLength : 1, '\0');
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(this->ID, i, maxLength, &length, &size, &type, &name[0]);
+        string uniform = name.substr(0, length);
+        GLint location = glGetUniformLocation(this->ID, uniform.c_str());
+        // Members of uniform blocks have no location; they are set through the block's buffer
+        if (location < 0)
+            continue;
+        uniformLocations[uniform] = location;
+        // Arrays are reported as "name[0]"; also allow looking them up as "name"
+        if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0)
+            uniformLocations[uniform.substr(0, uniform.size() - 3)] = location;
+    }
+
+    GLuint matrices = glGetUniformBlockIndex(this->ID, "Matrices");
+    if (matrices != GL_INVALID_INDEX)
+        glUniformBlockBinding(this->ID, matrices, MATRICES_BINDING);
+}
+
+int Shader::getLocation(std::string_view name) const {
+    auto location = uniformLocations.find(name);
+    return location != uniformLocations.end() ? location->second : -1;
 }
 
 void Shader::setFloat(const char *name, float value) const {
-    glUniform1f(glGetUniformLocation(this->ID, name), value);
+    glUniform1f(getLocation(name), value);
 }
 
 void Shader::setInteger(const char *name, int value) const {
-    glUniform1i(glGetUniformLocation(this->ID, name), value);
+    glUniform1i(getLocation(name), value);
 
 }
 
 void Shader::setVector2f(const char *name, float x, float y) const {
-    glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+    glUniform2f(getLocation(name), x, y);
 }
 
 void Shader::setVector2f(const char *name, const glm::vec2 &value) const {
-    glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    glUniform2f(getLocation(name), value.x, value.y);
 }
 
 void Shader::setVector3f(const char *name, float x, float y, float z) const {
-    glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    glUniform3f(getLocation(name), x, y, z);
 }
 
 void Shader::setVector3f(const char *name, const glm::vec3 &value) const {
-    glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    glUniform3f(getLocation(name), value.x, value.y, value.z);
 }
 
 void Shader::setVector4f(const char *name, float x, float y, float z, float w) const {
-    glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    glUniform4f(getLocation(name), x, y, z, w);
 }
 
 void Shader::setVector4f(const char *name, const glm::vec4 &value) const {
-    glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+    glUniform4f(getLocation(name), value.x, value.y, value.z, value.w);
 }
 
 void Shader::setMatrix4(const char *name, const glm::mat4 &matrix) const {
-    glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+    glUniformMatrix4fv(getLocation(name), 1, false, glm::value_ptr(matrix));
+}
+
+void Shader::setFloat(int location, float value) const {
+    glUniform1f(location, value);
+}
+
+void Shader::setInteger(int location, int value) const {
+    glUniform1i(location, value);
+}
+
+void Shader::setVector2f(int location, const glm::vec2 &value) const {
+    glUniform2f(location, value.x, value.y);
+}
+
+void Shader::setVector3f(int location, const glm::vec3 &value) const {
+    glUniform3f(location, value.x, value.y, value.z);
+}
+
+void Shader::setVector4f(int location, const glm::vec4 &value) const {
+    glUniform4f(location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::setMatrix4(int location, const glm::mat4 &matrix) const {
+    glUniformMatrix4fv(location, 1, false, glm::value_ptr(matrix));
 }
 
 
@@ -5,6 +5,10 @@
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
 using std::string, std::ifstream, std::stringstream, std::cout, std::endl;
 
 /// @brief General purpose shader object.
@@ -14,6 +18,10 @@ class Shader {
         /// @brief The shader program ID
         unsigned int ID;
 
+        /// @brief Binding point of the shared "Matrices" uniform block (see UniformBuffer).
+        /// @details Every shader that declares the block is bound to it after linking.
+        static constexpr unsigned int MATRICES_BINDING = 0;
+
         /// @brief Construct a new Shader object
         Shader() { }
 
@@ -29,6 +37,32 @@ class Shader {
         /// @param geometrySource the source code for the geometry shader (optional)
         void compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr); // note: geometry source code is optional
 
+        /// @brief Compile the shader from sources that are not null-terminated (e.g. views into the resource pack)
+        /// @details The sources are passed to the driver as they are, without copying them
+        /// @param geometrySource the source code for the geometry shader (optional)
+        void compile(const char *vertexSource, int vertexLength, const char *fragmentSource, int fragmentLength,
+                     const char *geometrySource = nullptr, int geometryLength = 0);
+
+        /// @brief Whether the driver can save and load linked programs (glGetProgramBinary/glProgramBinary)
+        /// @details Needs the entry points (GL 4.1 or ARB_get_program_binary) and at least one binary format
+        static bool supportsBinaries();
+
+        /// @brief Creates the program from a binary saved by getBinary()
+        /// @details Drivers reject binaries from other drivers or versions; that is not an error, the caller should
+        /// compile from source instead
+        /// @return false if the binary was rejected (the program is then deleted)
+        bool loadBinary(unsigned int format, const void *binary, int length);
+
+        /// @brief Gets the linked program as a binary, to load with loadBinary() on a later run
+        /// @return false if binaries are not supported or the driver returned none
+        bool getBinary(std::vector<unsigned char> &binary, unsigned int &format) const;
+
+        /// @brief Returns the location of an active uniform, looked up once after linking
+        /// @details Look the location up once and pass it to the set* overloads taking a location in hot paths.
+        /// @param name name of the uniform
+        /// @return the location, or -1 if the program has no such active uniform (setting it is then a no-op)
+        int getLocation(std::string_view name) const;
+
         // ------------------------------------------------------------------------
         // utility functions
         // ------------------------------------------------------------------------
@@ -87,7 +121,26 @@ class Shader {
         /// @param useShader boolean to indicate whether to use this shader
         void setMatrix4(const char *name, const glm::mat4 &matrix) const;
 
+        // ------------------------------------------------------------------------
+        // utility functions by cached location (from getLocation())
+        // ------------------------------------------------------------------------
+
+        void setFloat(int location, float value) const;
+        void setInteger(int location, int value) const;
+        void setVector2f(int location, const glm::vec2 &value) const;
+        void setVector3f(int location, const glm::vec3 &value) const;
+        void setVector4f(int location, const glm::vec4 &value) const;
+        void setMatrix4(int location, const glm::mat4 &matrix) const;
+
     private:
+        /// @brief Locations of the program's active uniforms (outside uniform blocks), by name
+        /// @details The comparator is transparent, so lookups by const char * or string_view build no std::string.
+        std::map<std::string, int, std::less<>> uniformLocations;
+
+        /// @brief Caches every active uniform's location, and binds the "Matrices" block to MATRICES_BINDING
+        /// @details Called once by compile(), after linking
+        void reflectUniforms();
+
         /// @brief Checks if compilation or linking failed and if so, print the error logs
         /// @param object the shader object to check
         /// @param type the type of shader object (vertex, fragment, geometry)
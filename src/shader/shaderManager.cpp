@@ -1,7 +1,20 @@
 #include "shaderManager.h"
+#include "../util/cache.h"
+#include "../util/hash.h"
+#include "../util/mappedFile.h"
+#include <cstdio>
+#include <cstring>
 #include <fstream>
-#include <sstream>
 
+/// @brief Header of a cached program binary, followed by the binary itself.
+struct ProgramCacheHeader {
+    char magic[4];
+    uint32_t format;    // binary format returned by glGetProgramBinary
+    uint64_t key;       // hash of the sources and the driver
+    uint32_t length;
+};
+
+static const char PROGRAM_CACHE_MAGIC[4] = {'L', 'O', 'S', '1'};
 
 ShaderManager::~ShaderManager() {
     clear();
@@ -11,6 +24,10 @@ Shader ShaderManager::loadShader(const char *vShaderFile, const char *fShaderFil
     return shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
 }
 
+Shader ShaderManager::loadShader(const ShaderFiles &files, std::string name) {
+    return shaders[name] = createProgram(files);
+}
+
 Shader &ShaderManager::getShader(std::string name) {
     return shaders[name];
 }
@@ -23,41 +40,100 @@ void ShaderManager::clear() {
 }
 
 Shader ShaderManager::loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile) {
-    // 1. retrieve the vertex/fragment source code from filePath
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::string geometryCode;
-    try {
-        // open files
-        std::ifstream vertexShaderFile(vShaderFile);
-        std::ifstream fragmentShaderFile(fShaderFile);
-        std::stringstream vShaderStream, fShaderStream;
-        // read file's buffer contents into streams
-        vShaderStream << vertexShaderFile.rdbuf();
-        fShaderStream << fragmentShaderFile.rdbuf();
-        // close file handlers
-        vertexShaderFile.close();
-        fragmentShaderFile.close();
-        // convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-        // if geometry shader path is present, also load a geometry shader
-        if (gShaderFile != nullptr) {
-            std::ifstream geometryShaderFile(gShaderFile);
-            std::stringstream gShaderStream;
-            gShaderStream << geometryShaderFile.rdbuf();
-            geometryShaderFile.close();
-            geometryCode = gShaderStream.str();
-        }
-    }
-    catch (std::exception &e) {
+    return createProgram(readShaderFiles(vShaderFile, fShaderFile, gShaderFile));
+}
+
+ShaderManager::ShaderFiles ShaderManager::readShaderFiles(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile) {
+    // 1. open the vertex/fragment (and geometry) sources in the resource pack
+    ShaderFiles files;
+    files.vertex = ResourcePack::open(vShaderFile);
+    files.fragment = ResourcePack::open(fShaderFile);
+    files.hasGeometry = gShaderFile != nullptr;
+    if (files.hasGeometry)
+        files.geometry = ResourcePack::open(gShaderFile);
+    if (!files.vertex.isOpen() || !files.fragment.isOpen() || (files.hasGeometry && !files.geometry.isOpen())) {
         std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
     }
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
-    const char *gShaderCode = geometryCode.c_str();
-    // 2. now create shader object from source code
+
+    // 2. hash the sources, part of the key of the program binary
+    files.sourceHash = fnv1a64(files.vertex.data(), files.vertex.size());
+    files.sourceHash = fnv1a64(files.fragment.data(), files.fragment.size(), files.sourceHash);
+    files.sourceHash = fnv1a64(files.geometry.data(), files.geometry.size(), files.sourceHash);
+    return files;
+}
+
+Shader ShaderManager::createProgram(const ShaderFiles &files) {
+    // a missing source would pass a null pointer to the driver (and cache a broken program), so make no program
+    if (!files.vertex.isOpen() || !files.fragment.isOpen() || (files.hasGeometry && !files.geometry.isOpen())) {
+        std::cout << "ERROR::SHADER: Missing shader source, program not created" << std::endl;
+        Shader missing;
+        missing.ID = 0;
+        return missing;
+    }
+
+    // key the program by its sources and the driver, since binaries only load on the driver that made them
+    if (driverHash == 0) {
+        uint64_t hash = FNV1A_OFFSET;
+        for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+            const GLubyte *value = glGetString(name);
+            if (value != nullptr)
+                hash = fnv1a64(reinterpret_cast<const char *>(value), hash);
+        }
+        driverHash = hash;
+    }
+    uint64_t key = fnv1a64(&files.sourceHash, sizeof(files.sourceHash), driverHash);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "program_%016llx.bin", static_cast<unsigned long long>(key));
+    std::string binaryPath = cachePath(name);
+
+    // create the program from its binary, when the driver accepts it
     Shader shader;
-    shader.compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
+    if (loadBinary(binaryPath, key, shader))
+        return shader;
+
+    // otherwise compile it from source, straight from the pack, and cache its binary for next time
+    shader.compile(reinterpret_cast<const char *>(files.vertex.data()), static_cast<int>(files.vertex.size()),
+                   reinterpret_cast<const char *>(files.fragment.data()), static_cast<int>(files.fragment.size()),
+                   files.hasGeometry ? reinterpret_cast<const char *>(files.geometry.data()) : nullptr,
+                   static_cast<int>(files.geometry.size()));
+    saveBinary(binaryPath, key, shader);
     return shader;
-}
\ No newline at end of file
+}
+
+bool ShaderManager::loadBinary(const std::string &path, uint64_t key, Shader &shader) {
+    if (!Shader::supportsBinaries())
+        return false;
+
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(ProgramCacheHeader))
+        return false;
+    ProgramCacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, PROGRAM_CACHE_MAGIC, sizeof(PROGRAM_CACHE_MAGIC)) != 0 || header.key != key ||
+        file.size() != sizeof(ProgramCacheHeader) + header.length)
+        return false;
+
+    // A driver update can reject the binary; the caller then compiles from source and replaces it
+    return shader.loadBinary(header.format, file.data() + sizeof(ProgramCacheHeader), static_cast<int>(header.length));
+}
+
+void ShaderManager::saveBinary(const std::string &path, uint64_t key, const Shader &shader) {
+    std::vector<unsigned char> binary;
+    unsigned int format = 0;
+    if (!shader.getBinary(binary, format))
+        return;
+
+    ProgramCacheHeader header{};
+    std::memcpy(header.magic, PROGRAM_CACHE_MAGIC, sizeof(PROGRAM_CACHE_MAGIC));
+    header.format = format;
+    header.key = key;
+    header.length = static_cast<uint32_t>(binary.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(binary.data()), static_cast<std::streamsize>(binary.size()));
+    if (!out) {
+        std::cout << "ERROR::SHADER: Failed to save program binary to " << path << std::endl;
+    }
+}
@@ -2,12 +2,37 @@
 #define GRAPHICS_SHADERMANAGER_H
 
 #include "shader.h"
+#include "../util/resourcePack.h"
 
+#include <cstdint>
 #include <map>
 #include <iostream>
 
+/**
+ * @brief Loads, compiles and stores the shaders by name.
+ * @details Linked programs are cached as driver binaries in the cache directory, keyed by a hash of their sources
+ * and the driver (vendor, renderer and version). On later launches a program is created from its binary with one
+ * call, and compiled from source only when there is no binary or the driver rejects it.
+ */
 class ShaderManager {
 public:
+    /// @brief A program's sources, as views into the resource pack, hashed ahead of compiling
+    /// @details Made by readShaderFiles() without OpenGL, so shaders can be read on a worker thread while the
+    /// context is created
+    struct ShaderFiles {
+        Resource vertex, fragment, geometry;
+        bool hasGeometry = false;
+
+        /// @brief FNV-1a hash of the sources, combined with the driver's to key the program binary
+        uint64_t sourceHash = 0;
+    };
+
+    /// @brief Opens and hashes a program's sources. Makes no OpenGL calls, so it is safe on any thread.
+    /// @param vShaderFile The vertex shader's resource name (e.g. "shaders/shape.vert")
+    /// @param fShaderFile The fragment shader's resource name
+    /// @param gShaderFile The geometry shader's resource name (optional)
+    static ShaderFiles readShaderFiles(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile = nullptr);
+
     /// @brief Default constructor
     ShaderManager() = default;
     /// @brief Default destructor
@@ -16,13 +41,19 @@ public:
 
 
     /// @brief Calls loadShaderFromFile() and stores the shader in the shaders map
-    /// @param vShaderFile The vertex shader file
-    /// @param fShaderFile The fragment shader file
-    /// @param gShaderFile The geometry shader file (optional)
+    /// @param vShaderFile The vertex shader's resource name
+    /// @param fShaderFile The fragment shader's resource name
+    /// @param gShaderFile The geometry shader's resource name (optional)
     /// @param name Name used for the shader in the shaders map
     /// @return The shader that was loaded
     Shader loadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name);
 
+    /// @brief Creates a program from source files read by readShaderFiles() and stores it in the shaders map
+    /// @param files The program's source files
+    /// @param name Name used for the shader in the shaders map
+    /// @return The shader that was loaded
+    Shader loadShader(const ShaderFiles &files, std::string name);
+
     /// @brief Returns a reference to the shader with the given name in the shaders map
     /// @param name The name of the shader
     /// @return The shader with the given name
@@ -35,11 +66,25 @@ private:
     /// @brief A map of shaders, with the key being the name of the shader
     std::map<std::string, Shader> shaders;
 
-     /// @brief Loads and compiles a shader from a file
+    /// @brief Hash of the driver's vendor, renderer and version strings, mixed into every binary's key
+    /// @details Computed on first use, since it needs a current OpenGL context
+    uint64_t driverHash = 0;
+
+    /// @brief Creates a program from its cached binary, or compiles it from source and caches its binary
+    /// @details Needs the OpenGL context, so it runs on the main thread
+    Shader createProgram(const ShaderFiles &files);
+
+    /// @brief Creates a program from its cached binary, if there is one the driver accepts
+    bool loadBinary(const std::string &path, uint64_t key, Shader &shader);
+
+    /// @brief Saves a program's binary to the cache
+    void saveBinary(const std::string &path, uint64_t key, const Shader &shader);
+
+     /// @brief Loads and compiles a shader from the resource pack
      /// @details This function is private because we only want to load shaders from within this class
-     /// @param vShaderFile The vertex shader file
-     /// @param fShaderFile The fragment shader file
-     /// @param gShaderFile The geometry shader file (optional)
+     /// @param vShaderFile The vertex shader's resource name
+     /// @param fShaderFile The fragment shader's resource name
+     /// @param gShaderFile The geometry shader's resource name (optional)
      /// @return The shader that was loaded
     Shader loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile=nullptr);};
 
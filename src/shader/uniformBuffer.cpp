@@ -0,0 +1,19 @@
+#include "uniformBuffer.h"
+
+UniformBuffer::UniformBuffer(unsigned int binding, size_t size) {
+    glGenBuffers(1, &ID);
+    glBindBuffer(GL_UNIFORM_BUFFER, ID);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, ID);
+}
+
+UniformBuffer::~UniformBuffer() {
+    glDeleteBuffers(1, &ID);
+}
+
+void UniformBuffer::update(size_t offset, size_t size, const void *data) const {
+    glBindBuffer(GL_UNIFORM_BUFFER, ID);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
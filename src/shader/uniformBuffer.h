@@ -0,0 +1,34 @@
+#ifndef GRAPHICS_UNIFORMBUFFER_H
+#define GRAPHICS_UNIFORMBUFFER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+
+/// @brief A uniform buffer object bound to a fixed binding point, shared by every shader whose uniform block is
+/// bound to the same point.
+/// @details Used for the std140 "Matrices" block, so the projection is uploaded once for all shaders instead of
+/// once per shader.
+class UniformBuffer {
+public:
+    /// @brief Creates the buffer and binds it to a binding point
+    /// @param binding the binding point (e.g. Shader::MATRICES_BINDING)
+    /// @param size the size of the block in bytes, following std140 layout rules
+    UniformBuffer(unsigned int binding, size_t size);
+
+    UniformBuffer(UniformBuffer const &other) = delete;
+    UniformBuffer &operator=(UniformBuffer const &other) = delete;
+
+    /// @brief Deletes the buffer
+    ~UniformBuffer();
+
+    /// @brief Uploads data to part of the buffer
+    /// @param offset byte offset of the member in the block (std140)
+    /// @param size size of the data in bytes
+    /// @param data the data to upload
+    void update(size_t offset, size_t size, const void *data) const;
+
+private:
+    unsigned int ID;
+};
+
+#endif //GRAPHICS_UNIFORMBUFFER_H
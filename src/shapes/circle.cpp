@@ -0,0 +1,32 @@
+#include "circle.h"
+#include "../util/color.h"
+
+#include <algorithm>
+
+Circle::Circle(Shader & shader, vec2 pos, float radius, struct color color)
+        : Shape(shader, pos, vec2(2 * radius, 2 * radius), color) {
+    mesh = MeshRegistry::get(MeshRegistry::Quad);
+}
+
+Circle::Circle(Circle const& other) : Shape(other) {}
+
+void Circle::draw() const {
+    setAttributes();
+    mesh->draw();
+}
+
+float Circle::getRadius() const         { return std::min(size.x, size.y) / 2; }
+void Circle::setRadius(float radius)    { size = vec2(2 * radius, 2 * radius); }
+float Circle::getCornerRadius() const   { return getRadius(); }
+
+bool Circle::isOverlapping(const vec2 &point) const {
+    vec2 offset = point - pos;
+    float radius = getRadius();
+    return offset.x * offset.x + offset.y * offset.y <= radius * radius;
+}
+
+// Overridden Getters from Shape
+float Circle::getLeft() const        { return pos.x - getRadius(); }
+float Circle::getRight() const       { return pos.x + getRadius(); }
+float Circle::getTop() const         { return pos.y + getRadius(); }
+float Circle::getBottom() const      { return pos.y - getRadius(); }
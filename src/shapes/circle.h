@@ -0,0 +1,45 @@
+#ifndef GRAPHICS_CIRCLE_H
+#define GRAPHICS_CIRCLE_H
+
+#include "shape.h"
+#include "../shader/shader.h"
+using glm::vec2;
+
+
+class Circle : public Shape {
+public:
+    /// @brief Construct a new Circle object
+    /// @details Shares the unit quad mesh with every Rect; the shape shader cuts the circle out of it, so there is no
+    /// circle geometry to tessellate.
+    /// @param shader The shader to use
+    /// @param pos The center of the circle
+    /// @param radius The radius of the circle
+    /// @param color The color of the circle
+    Circle(Shader & shader, vec2 pos, float radius, struct color color);
+
+    Circle(Circle const& other);
+
+    /// @brief Destroy the Circle object. The shared mesh is deleted with the last shape using it.
+    ~Circle() override = default;
+
+    /// @brief Sets the shape's attributes and draws the shared quad.
+    void draw() const override;
+
+    float getRadius() const;
+    void setRadius(float radius);
+
+    /// @brief Half the smaller side, which turns the rounded rectangle into a circle.
+    float getCornerRadius() const override;
+
+    float getLeft() const override;
+    float getRight() const override;
+    float getTop() const override;
+    float getBottom() const override;
+
+    /// @brief A point overlaps the circle if it is within the radius of the center.
+    bool isOverlapping(const vec2& point) const override;
+
+};
+
+
+#endif //GRAPHICS_CIRCLE_H
@@ -0,0 +1,112 @@
+#include "gridRenderer.h"
+
+#include <algorithm>
+#include <cstddef>
+
+GridRenderer::GridRenderer(Shader &shader, size_t count)
+        : shader(shader), quad(MeshRegistry::get(MeshRegistry::Quad)), instances(count, Instance{}),
+          dirty(count, false) {
+    // every instance can be dirty at once, so marking them never allocates
+    dirtyIndices.reserve(count);
+
+    // Reuse the shared unit quad's buffers in a VAO that also has the instance attributes
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quad->getVBO());
+    glVertexAttribPointer(ATTRIBUTE_CORNER, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(ATTRIBUTE_CORNER);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad->getEBO());
+
+    // Instance attributes (position, size, colours, border and radius) advance once per instance instead of once
+    // per vertex
+    glGenBuffers(1, &instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(Instance), nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(ATTRIBUTE_CENTER, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, pos));
+    glVertexAttribPointer(ATTRIBUTE_SIZE, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, size));
+    glVertexAttribPointer(ATTRIBUTE_FILL, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, color));
+    glVertexAttribPointer(ATTRIBUTE_BORDER_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, borderColor));
+    glVertexAttribPointer(ATTRIBUTE_BORDER, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, borderWidth));
+    for (unsigned int attribute = ATTRIBUTE_CENTER; attribute <= ATTRIBUTE_BORDER; attribute++) {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0); // The EBO stays bound to the VAO
+}
+
+GridRenderer::~GridRenderer() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &instanceVBO);
+}
+
+void GridRenderer::setInstance(size_t index, vec2 pos, vec2 size, color color, float radius, float borderWidth) {
+    instances[index] = Instance{pos, size, color.vec, vec4(0.0f), borderWidth, radius};
+    markDirty(index);
+}
+
+void GridRenderer::setColor(size_t index, color color) {
+    instances[index].color = color.vec;
+    markDirty(index);
+}
+
+void GridRenderer::setBorderColor(size_t index, color color) {
+    instances[index].borderColor = color.vec;
+    markDirty(index);
+}
+
+void GridRenderer::setOpacity(size_t index, float alpha) {
+    instances[index].color.w = alpha;
+    markDirty(index);
+}
+
+const GridRenderer::Instance &GridRenderer::getInstance(size_t index) const { return instances[index]; }
+size_t GridRenderer::size() const { return instances.size(); }
+
+void GridRenderer::markDirty(size_t index) {
+    if (!dirty[index]) {
+        dirty[index] = true;
+        dirtyIndices.push_back(index);
+    }
+}
+
+void GridRenderer::upload() {
+    if (dirtyIndices.empty())
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (dirtyIndices.size() * 4 >= instances.size()) {
+        // Most of the buffer changed (e.g. a new puzzle), so one upload of everything is cheaper
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(Instance), instances.data());
+    } else {
+        // A move changes a handful of instances: upload each run of consecutive ones
+        std::sort(dirtyIndices.begin(), dirtyIndices.end());
+        for (size_t first = 0; first < dirtyIndices.size();) {
+            size_t last = first;
+            while (last + 1 < dirtyIndices.size() && dirtyIndices[last + 1] == dirtyIndices[last] + 1)
+                last++;
+            size_t begin = dirtyIndices[first], count = last - first + 1;
+            glBufferSubData(GL_ARRAY_BUFFER, begin * sizeof(Instance), count * sizeof(Instance), &instances[begin]);
+            first = last + 1;
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    for (size_t index : dirtyIndices)
+        dirty[index] = false;
+    dirtyIndices.clear();
+}
+
+void GridRenderer::draw() {
+    if (instances.empty())
+        return;
+
+    upload();
+
+    shader.use();
+    glBindVertexArray(VAO);
+    glDrawElementsInstanced(GL_TRIANGLES, quad->getIndexCount(), GL_UNSIGNED_INT, 0, static_cast<GLsizei>(instances.size()));
+    glBindVertexArray(0);
+}
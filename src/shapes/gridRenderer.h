@@ -0,0 +1,84 @@
+#ifndef GRAPHICS_GRIDRENDERER_H
+#define GRAPHICS_GRIDRENDERER_H
+
+#include "glm/glm.hpp"
+#include <vector>
+#include "../shader/shader.h"
+#include "../util/color.h"
+#include "mesh.h"
+using std::vector, glm::vec2, glm::vec4;
+
+/**
+ * @brief Draws many rectangles, rounded rectangles and circles (e.g. the light grid) with one instanced draw call.
+ * @details Every shape shares one unit quad, and the shape shader cuts it to shape with a signed distance function.
+ * Each one is an instance with its own position, size, fill, border and corner radius, kept in a per-instance vertex
+ * buffer. Only the instances changed since the last draw are re-uploaded. Instances are drawn in index order, so
+ * later instances are drawn on top.
+ */
+class GridRenderer {
+public:
+    /// @brief Per-instance data, laid out as the shape shader's instanced attributes (see ShapeAttribute).
+    struct Instance {
+        vec2 pos;
+        vec2 size;
+        vec4 color;
+        vec4 borderColor;
+        /// @brief Width of the border drawn outside the shape, and the corner radius (half the side for a circle).
+        float borderWidth, radius;
+    };
+
+    /// @brief Construct a renderer for a fixed number of instances, all zero-sized until set.
+    /// @param shader The shape shader (res/shaders/shape.vert and shape.frag)
+    /// @param count The number of instances
+    GridRenderer(Shader &shader, size_t count);
+
+    GridRenderer(GridRenderer const &other) = delete;
+    GridRenderer &operator=(GridRenderer const &other) = delete;
+
+    /// @brief Destroy the renderer and delete its VAO and buffers.
+    ~GridRenderer();
+
+    /// @brief Sets an instance's position (its center), size, colour and shape.
+    /// @param radius The corner radius: 0 for a rectangle, half the side of a square for a circle
+    /// @param borderWidth The width of the border drawn around the shape, in its border colour (transparent until set)
+    void setInstance(size_t index, vec2 pos, vec2 size, color color, float radius = 0, float borderWidth = 0);
+
+    /// @brief Sets an instance's colour.
+    void setColor(size_t index, color color);
+
+    /// @brief Sets the colour of an instance's border; transparent hides it.
+    void setBorderColor(size_t index, color color);
+
+    /// @brief Sets an instance's opacity, keeping its colour.
+    void setOpacity(size_t index, float alpha);
+
+    const Instance &getInstance(size_t index) const;
+    size_t size() const;
+
+    /// @brief Uploads the instances that changed, and draws them all with one call using the shader.
+    /// @details The projection comes from the shared "Matrices" uniform buffer, so it must be uploaded first.
+    void draw();
+
+private:
+    Shader &shader;
+
+    /// @brief The unit quad, shared with every Shape.
+    shared_ptr<Mesh> quad;
+
+    /// @brief The Vertex Array Object (the quad's buffers plus the instance attributes) and the instance buffer.
+    unsigned int VAO, instanceVBO;
+
+    vector<Instance> instances;
+
+    /// @brief The instances changed since they were last uploaded, and a flag per instance so each is listed once.
+    vector<size_t> dirtyIndices;
+    vector<bool> dirty;
+
+    /// @brief Adds an instance to the ones to upload on the next draw.
+    void markDirty(size_t index);
+
+    /// @brief Uploads the changed instances, one glBufferSubData per run of consecutive indices.
+    void upload();
+};
+
+#endif //GRAPHICS_GRIDRENDERER_H
@@ -0,0 +1,65 @@
+#include "mesh.h"
+
+Mesh::Mesh(const vector<float> &vertices, const vector<unsigned int> &indices)
+        : indexCount(static_cast<GLsizei>(indices.size())) {
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    // Set the vertex attribute pointers (2 floats per vertex (x, y))
+    glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(ATTRIBUTE_CORNER, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(ATTRIBUTE_CORNER);
+
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0); // The EBO stays bound to the VAO
+}
+
+Mesh::~Mesh() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+}
+
+void Mesh::draw() const {
+    glBindVertexArray(VAO);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+unsigned int Mesh::getVBO() const   { return VBO; }
+unsigned int Mesh::getEBO() const   { return EBO; }
+GLsizei Mesh::getIndexCount() const { return indexCount; }
+
+std::map<MeshRegistry::Primitive, weak_ptr<Mesh>> &MeshRegistry::meshes() {
+    static std::map<Primitive, weak_ptr<Mesh>> meshes;
+    return meshes;
+}
+
+shared_ptr<Mesh> MeshRegistry::get(Primitive primitive) {
+    weak_ptr<Mesh> &entry = meshes()[primitive];
+    if (shared_ptr<Mesh> mesh = entry.lock())
+        return mesh;
+
+    shared_ptr<Mesh> mesh;
+    switch (primitive) {
+        case Quad:
+            mesh = std::make_shared<Mesh>(vector<float>{
+                    0.5f, -0.5f,  // x, y of bottom right corner
+                    0.5f, 0.5f,   // x, y of top right corner
+                    -0.5f, -0.5f, // x, y of bottom left corner
+                    -0.5f, 0.5f   // x, y of top left corner
+            }, vector<unsigned int>{
+                    0, 1, 2, // First triangle
+                    1, 2, 3  // Second triangle
+            });
+            break;
+    }
+    entry = mesh;
+    return mesh;
+}
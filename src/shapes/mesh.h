@@ -0,0 +1,73 @@
+#ifndef GRAPHICS_MESH_H
+#define GRAPHICS_MESH_H
+
+#include <glad/glad.h>
+#include <map>
+#include <memory>
+#include <vector>
+using std::vector, std::shared_ptr, std::weak_ptr;
+
+/// @brief Vertex attribute locations of the shape shader (res/shaders/shape.vert).
+/// @details A Mesh only feeds ATTRIBUTE_CORNER. The rest describe one shape: GridRenderer streams them per instance,
+/// and a single Shape sets them as constant attributes before drawing.
+enum ShapeAttribute : unsigned int {
+    ATTRIBUTE_CORNER = 0,
+    ATTRIBUTE_CENTER,
+    ATTRIBUTE_SIZE,
+    ATTRIBUTE_FILL,
+    ATTRIBUTE_BORDER_COLOR,
+    ATTRIBUTE_BORDER,   // border width and corner radius
+};
+
+/**
+ * @brief Indexed 2D geometry on the GPU: a VAO, a VBO of (x, y) vertices at attribute 0, and an EBO.
+ * @details Owns its buffers and deletes all three when destroyed. Meshes are shared through MeshRegistry rather
+ * than created per shape.
+ */
+class Mesh {
+public:
+    /// @brief Uploads the vertices (2 floats each) and indices.
+    Mesh(const vector<float> &vertices, const vector<unsigned int> &indices);
+
+    Mesh(Mesh const &other) = delete;
+    Mesh &operator=(Mesh const &other) = delete;
+
+    /// @brief Deletes the VAO, VBO and EBO.
+    ~Mesh();
+
+    /// @brief Binds the VAO and draws the mesh.
+    void draw() const;
+
+    /// @brief The vertex and index buffers, for renderers that build their own VAO around the same geometry.
+    unsigned int getVBO() const;
+    unsigned int getEBO() const;
+    GLsizei getIndexCount() const;
+
+private:
+    unsigned int VAO, VBO, EBO;
+    GLsizei indexCount;
+};
+
+/**
+ * @brief Hands out one shared Mesh per primitive type.
+ * @details The registry only keeps weak references: a mesh is created by the first get() for its primitive, and
+ * deleted when the last shape using it is destroyed. Creating more shapes of a type that is already in use costs
+ * no GPU allocation.
+ */
+class MeshRegistry {
+public:
+    enum Primitive {
+        /// A unit square centered on the origin (corners at +-0.5), drawn as two triangles.
+        Quad
+    };
+
+    /// @brief Returns the mesh for a primitive, creating it if no shape is using it.
+    /// @note Needs a current OpenGL context.
+    static shared_ptr<Mesh> get(Primitive primitive);
+
+private:
+    /// @brief The mesh in use for each primitive, if any.
+    static std::map<Primitive, weak_ptr<Mesh>> &meshes();
+};
+
+#endif //GRAPHICS_MESH_H
@@ -8,25 +8,21 @@ using glm::vec2, glm::vec3;
 
 
 class Rect : public Shape {
-private:
-    /// @brief Initializes the vertices and indices of the square
-    void initVectors();
-    int status;
 public:
     /// @brief Construct a new Square object
-    /// @details This constructor will call the InitRenderData function.
+    /// @details Shares the unit quad mesh with every other Rect, so no GPU buffers are created.
     /// @param shader The shader to use
     /// @param pos The position of the square
     /// @param size The size of the square
     /// @param color The color of the square
-    Rect(Shader & shader, vec2 pos, vec2 size, struct color color, int status);
+    Rect(Shader & shader, vec2 pos, vec2 size, struct color color);
 
     Rect(Rect const& other);
 
-    /// @brief Destroy the Square object and delete it's VAO and VBO
-    ~Rect();
+    /// @brief Destroy the Square object. The shared mesh is deleted with the last shape using it.
+    ~Rect() override = default;
 
-    /// @brief Binds the VAO and calls the virtual draw function
+    /// @brief Sets the shape's attributes and draws the shared quad. Rounded when given a corner radius.
     void draw() const override;
 
     float getLeft() const override;
@@ -1,69 +1,26 @@
 #include "shape.h"
 
 
-Shape::Shape(Shader &shader, glm::vec2 pos, glm::vec2 size, struct color color, int s) :
-        shader(shader), pos(pos), size(size), shapeColor(color), status(s) {}
+Shape::Shape(Shader &shader, glm::vec2 pos, glm::vec2 size, struct color color) :
+        shader(shader), pos(pos), size(size), shapeColor(color) {}
 
 Shape::Shape(Shape const& other) :
-        shader(other.shader), pos(other.pos), size(other.size), shapeColor(other.shapeColor) {}
+        shader(other.shader), pos(other.pos), size(other.size), shapeColor(other.shapeColor),
+        borderColor(other.borderColor), borderWidth(other.borderWidth), cornerRadius(other.cornerRadius),
+        mesh(other.mesh) {}
 
-int Shape::getStatus() const {
-    return status;
-}
-
-void Shape::toggleStatus() {
-    if (this->getStatus() == 1) {
-        status = 0;
-    } else if (this->getStatus() == 0) {
-        status = 1;
-    } else {
-        status = 0;
-    }
-}
-
-// Initialize VAO
-unsigned int Shape::initVAO() {
-    glGenVertexArrays(1, &VAO); // Generate VAO
-    glBindVertexArray(VAO); // Bind VAO
-    return VAO;
-}
-
-// Initialize VBO
-void Shape::initVBO() {
-    // Generate VBO, bind it to VAO, and copy vertices data into it
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    // Set the vertex attribute pointers (2 floats per vertex (x, y))
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0); // Enable the vertex attribute at location 0
-    glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbind VBO
-}
-
-// Initialize EBO
-void Shape::initEBO() {
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(float), indices.data(), GL_STATIC_DRAW);
-    // Don't unbind EBO because it's bound to VAO
-}
-
-void Shape::setUniforms() const {
+void Shape::setAttributes() const {
     // If you want to use a custom shader, you have to set it and call it's Use() function here.
-    // Since we are using the same shader for all shapes, we can just set it once in the constructor.
+    // Since we are using the same shader for all shapes, the caller uses it once before drawing them.
     //this->shader.use();
 
-    // Define the model matrix for the shape as a 4x4 identity matrix
-    mat4 model = mat4(1.0f);
-    // The model matrix is used to transform the vertices of the shape in relation to the world space.
-    model = translate(model, vec3(pos, 1.0f));
-    // The size of the shape is scaled by the model matrix to make the shape larger or smaller.
-    model = scale(model, vec3(size, 1.0f));
-
-    // Set the model matrix and color uniform variables in the shader
-    this->shader.setMatrix4("model", model);
-    this->shader.setVector4f("shapeColor", shapeColor.vec);
+    // The attributes the mesh does not feed keep these values for every vertex. The shader moves and scales the
+    // unit quad to the shape, and cuts out its outline (and border) with a signed distance function.
+    glVertexAttrib2f(ATTRIBUTE_CENTER, pos.x, pos.y);
+    glVertexAttrib2f(ATTRIBUTE_SIZE, size.x, size.y);
+    glVertexAttrib4f(ATTRIBUTE_FILL, shapeColor.red, shapeColor.green, shapeColor.blue, shapeColor.alpha);
+    glVertexAttrib4f(ATTRIBUTE_BORDER_COLOR, borderColor.red, borderColor.green, borderColor.blue, borderColor.alpha);
+    glVertexAttrib2f(ATTRIBUTE_BORDER, borderWidth, getCornerRadius());
 }
 
 bool Shape::isOverlapping(const vec2 &point) const {
@@ -91,6 +48,9 @@ void Shape::setGreen(float g)    { shapeColor.green = g; }
 void Shape::setBlue(float b)     { shapeColor.blue = b; }
 void Shape::setOpacity(float a)  { shapeColor.alpha = a; }
 
+void Shape::setBorder(struct color c, float width) { borderColor = c; borderWidth = width; }
+void Shape::setCornerRadius(float radius)          { cornerRadius = radius; }
+
 void Shape::setSize(vec2 size) { this->size = size; }
 void Shape::setSizeX(float x)  { size.x = x; }
 void Shape::setSizeY(float y)  { size.y = y; }
@@ -104,6 +64,9 @@ vec2 Shape::getPos() const      { return pos; }
 float Shape::getPosX() const    { return pos.x; }
 float Shape::getPosY() const    { return pos.y; }
 vec2 Shape::getSize() const     { return size; }
+color Shape::getBorderColor() const   { return borderColor; }
+float Shape::getBorderWidth() const   { return borderWidth; }
+float Shape::getCornerRadius() const  { return cornerRadius; }
 vec3 Shape::getColor3() const   { return {shapeColor.red, shapeColor.green, shapeColor.blue}; }
 vec4 Shape::getColor4() const   { return shapeColor.vec; }
 float Shape::getRed() const     { return shapeColor.red; }
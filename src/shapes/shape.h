@@ -5,6 +5,7 @@
 #include <vector>
 #include "../shader/shader.h"
 #include "../util/color.h"
+#include "mesh.h"
 using std::vector, glm::vec2, glm::vec3, glm::vec4, glm::mat4, glm::translate, glm::scale;
 
 class Shape {
@@ -14,7 +15,7 @@ public:
     /// @param pos The position of the shape
     /// @param size The size of the shape
     /// @param color The color of the shape
-    Shape(Shader& shader, vec2 pos, glm::vec2 size, color color, int s);
+    Shape(Shader& shader, vec2 pos, glm::vec2 size, color color);
 
     /// @brief Copy constructor for Shape
     Shape(Shape const& other);
@@ -22,23 +23,6 @@ public:
     /// @brief Destroy the Shape object
     virtual ~Shape() = default;
 
-    // --------------------------------------------------------
-    // Initialization functions
-    // --------------------------------------------------------
-
-    /// @brief Initializes the VAO.
-    /// @details This function is called in the derived classes' constructor.
-    unsigned int initVAO();
-
-    /// @brief Initializes the VBO.
-    /// @details This function is called in the derived classes' constructor.
-    void initVBO();
-
-    /// @brief Initializes the EBO.
-    /// @details This function is called in the derived classes' constructor.
-    /// @details If function has no indices, pass nullptr for indices and 0 for indexCount.
-    void initEBO();
-
     // --------------------------------------------------------
     // Getters
     // --------------------------------------------------------
@@ -50,8 +34,12 @@ public:
     virtual float getRight() const = 0;
     virtual float getTop() const = 0;
     virtual float getBottom() const = 0;
-    int getStatus() const;
-    void toggleStatus();
+
+    // Border and corner Functions
+    color getBorderColor() const;
+    float getBorderWidth() const;
+    /// @brief The radius of the corners, 0 for a rectangle.
+    virtual float getCornerRadius() const;
 
     // Color Functions
     vec4 getColor4() const;
@@ -91,6 +79,11 @@ public:
     void setSizeX(float x);
     void setSizeY(float y);
 
+    // Border and corners
+    /// @brief Sets the border drawn around the shape; a width of 0 (the default) draws none.
+    void setBorder(color color, float width);
+    void setCornerRadius(float radius);
+
     // Change Functions
     void update(float deltaTime);
 
@@ -112,10 +105,12 @@ public:
     // Drawing functions
     // --------------------------------------------------------
 
-    /// @brief Sets the uniform variables from members, and calls the virtual draw function
-    void setUniforms() const;
+    /// @brief Sets the shape shader's per-shape attributes from members, as constant vertex attributes
+    /// @details The mesh only feeds the quad corners, so the rest of the shape (see ShapeAttribute) is the same for
+    /// every vertex, and the shader draws it exactly as it would an instance of GridRenderer.
+    void setAttributes() const;
 
-    /// @brief Pure virtual function to draw the shape.
+    /// @brief Pure virtual function to draw the shape. Calls setAttributes() first.
     virtual void draw() const = 0;
 
 protected:
@@ -129,19 +124,16 @@ protected:
     //
     vec2 size;
 
-    /// @brief The VAO of the shape
+    /// @brief The fill color of the shape
     color shapeColor;
 
-    /// @brief The Vertex Array Object, Vertex Buffer Object, and Element Buffer Object of the shape.
-    unsigned int VAO, VBO, EBO;
-
-    /// @brief The vertices of the shape
-    vector<float> vertices;
-
-    /// @brief The indices of the shape
-    vector<unsigned int> indices;
+    /// @brief The border around the shape (none until setBorder() is called) and the corner radius
+    color borderColor = color(0, 0, 0, 0);
+    float borderWidth = 0, cornerRadius = 0;
 
-    int status;
+    /// @brief The unit-sized geometry of the shape, shared with every shape of the same type.
+    /// @details Set in the derived classes' constructor from MeshRegistry, and scaled to the shape in the shader.
+    shared_ptr<Mesh> mesh;
 };
 
 #endif //GRAPHICS_SHAPE_H
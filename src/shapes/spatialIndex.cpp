@@ -0,0 +1,61 @@
+#include "spatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialIndex::SpatialIndex(float width, float height, float bucketSize) : bucketSize(std::max(1.0f, bucketSize)) {
+    columns = std::max(1, static_cast<int>(std::ceil(width / this->bucketSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(height / this->bucketSize)));
+}
+
+void SpatialIndex::bucketRange(const Shape *shape, int &firstCol, int &lastCol, int &firstRow, int &lastRow) const {
+    firstCol = std::clamp(static_cast<int>(std::floor(shape->getLeft() / bucketSize)), 0, columns - 1);
+    lastCol = std::clamp(static_cast<int>(std::floor(shape->getRight() / bucketSize)), 0, columns - 1);
+    firstRow = std::clamp(static_cast<int>(std::floor(shape->getBottom() / bucketSize)), 0, rows - 1);
+    lastRow = std::clamp(static_cast<int>(std::floor(shape->getTop() / bucketSize)), 0, rows - 1);
+}
+
+void SpatialIndex::insert(const Shape *shape) {
+    if (buckets.empty())
+        buckets.resize(static_cast<size_t>(columns) * rows);
+
+    int firstCol, lastCol, firstRow, lastRow;
+    bucketRange(shape, firstCol, lastCol, firstRow, lastRow);
+    for (int r = firstRow; r <= lastRow; r++) {
+        for (int c = firstCol; c <= lastCol; c++)
+            buckets[static_cast<size_t>(r) * columns + c].push_back(shape);
+    }
+}
+
+void SpatialIndex::remove(const Shape *shape) {
+    if (buckets.empty())
+        return;
+    int firstCol, lastCol, firstRow, lastRow;
+    bucketRange(shape, firstCol, lastCol, firstRow, lastRow);
+    for (int r = firstRow; r <= lastRow; r++) {
+        for (int c = firstCol; c <= lastCol; c++) {
+            vector<const Shape *> &bucket = buckets[static_cast<size_t>(r) * columns + c];
+            bucket.erase(std::remove(bucket.begin(), bucket.end(), shape), bucket.end());
+        }
+    }
+}
+
+void SpatialIndex::clear() {
+    for (vector<const Shape *> &bucket : buckets)
+        bucket.clear();
+}
+
+const Shape *SpatialIndex::query(vec2 point) const {
+    int c = static_cast<int>(std::floor(point.x / bucketSize));
+    int r = static_cast<int>(std::floor(point.y / bucketSize));
+    if (buckets.empty() || c < 0 || r < 0 || c >= columns || r >= rows)
+        return nullptr;
+
+    // Later shapes are drawn on top, so check them first
+    const vector<const Shape *> &bucket = buckets[static_cast<size_t>(r) * columns + c];
+    for (auto it = bucket.rbegin(); it != bucket.rend(); ++it) {
+        if ((*it)->isOverlapping(point))
+            return *it;
+    }
+    return nullptr;
+}
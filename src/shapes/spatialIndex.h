@@ -0,0 +1,47 @@
+#ifndef GRAPHICS_SPATIALINDEX_H
+#define GRAPHICS_SPATIALINDEX_H
+
+#include "shape.h"
+
+#include <vector>
+using std::vector, glm::vec2;
+
+/**
+ * @brief A uniform grid of buckets over the window for finding the shapes under a point.
+ * @details Each shape is added to every bucket its bounding box touches, so a query only tests the shapes in one
+ * bucket instead of every shape. Shapes are not owned, and must be removed (or the index cleared) before they move
+ * or are destroyed. The buckets are only allocated when the first shape is inserted, so an unused index is free.
+ */
+class SpatialIndex {
+public:
+    /// @brief The default side length of a bucket in pixels, around the size of a button or label.
+    static constexpr float DEFAULT_BUCKET_SIZE = 64;
+
+    /// @brief Construct an index covering a width x height area with square buckets.
+    /// @param bucketSize The side length of a bucket, ideally around the size of a typical shape (at least a pixel)
+    SpatialIndex(float width, float height, float bucketSize = DEFAULT_BUCKET_SIZE);
+
+    /// @brief Adds a shape to the buckets its bounding box touches.
+    void insert(const Shape *shape);
+
+    /// @brief Removes a shape from the index.
+    void remove(const Shape *shape);
+
+    /// @brief Removes every shape.
+    void clear();
+
+    /// @brief Returns the most recently inserted shape overlapping a point, or nullptr if there is none.
+    const Shape *query(vec2 point) const;
+
+private:
+    float bucketSize;
+    int columns, rows;
+
+    /// @brief The shapes touching each bucket, row-major, in insertion order. Empty until the first insert().
+    vector<vector<const Shape *>> buckets;
+
+    /// @brief The range of buckets a shape's bounding box touches, clamped to the index.
+    void bucketRange(const Shape *shape, int &firstCol, int &lastCol, int &firstRow, int &lastRow) const;
+};
+
+#endif //GRAPHICS_SPATIALINDEX_H
@@ -0,0 +1,38 @@
+#include "allocationCounter.h"
+
+#ifdef LIGHTS_OUT_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // Constant-initialized, so counting never allocates or runs a thread_local constructor
+    thread_local size_t allocations = 0;
+
+    void *allocate(size_t size) {
+        allocations++;
+        if (void *memory = std::malloc(size == 0 ? 1 : size))
+            return memory;
+        throw std::bad_alloc();
+    }
+}
+
+// Replacing these covers every new and new[] (the aligned and nothrow forms forward to them or are rare here)
+void *operator new(size_t size)   { return allocate(size); }
+void *operator new[](size_t size) { return allocate(size); }
+void operator delete(void *memory) noexcept               { std::free(memory); }
+void operator delete[](void *memory) noexcept             { std::free(memory); }
+void operator delete(void *memory, size_t) noexcept       { std::free(memory); }
+void operator delete[](void *memory, size_t) noexcept     { std::free(memory); }
+
+size_t allocationCount() {
+    return allocations;
+}
+
+#else
+
+size_t allocationCount() {
+    return 0;
+}
+
+#endif
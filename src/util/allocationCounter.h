@@ -0,0 +1,21 @@
+#ifndef GRAPHICS_ALLOCATIONCOUNTER_H
+#define GRAPHICS_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+/// @brief Returns the number of heap allocations (calls to operator new) made so far by the calling thread.
+/// @details Only counted when built with LIGHTS_OUT_COUNT_ALLOCATIONS (the CMake option of the same name), which
+/// replaces the global operator new. Otherwise always returns 0. Counts are per thread, so worker threads (e.g. the
+/// solver's) never show up in the render loop's count.
+size_t allocationCount();
+
+/// @brief Whether allocations are being counted (see allocationCount()).
+constexpr bool countingAllocations() {
+#ifdef LIGHTS_OUT_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+#endif //GRAPHICS_ALLOCATIONCOUNTER_H
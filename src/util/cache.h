@@ -0,0 +1,19 @@
+#ifndef GRAPHICS_CACHE_H
+#define GRAPHICS_CACHE_H
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+/// @brief Returns the path of a file in the cache directory, creating the directory if needed.
+/// @details The cache directory is $LIGHTS_OUT_CACHE_DIR if set, otherwise "cache" in the working directory.
+/// Everything in it can be deleted; it is rebuilt on the next launch.
+inline std::string cachePath(const std::string &file) {
+    const char *custom = std::getenv("LIGHTS_OUT_CACHE_DIR");
+    std::filesystem::path dir = custom != nullptr ? custom : "cache";
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    return (dir / file).string();
+}
+
+#endif //GRAPHICS_CACHE_H
@@ -0,0 +1,72 @@
+#ifndef GRAPHICS_GRIDLAYOUT_H
+#define GRAPHICS_GRIDLAYOUT_H
+
+#include <glm/glm.hpp>
+#include <algorithm>
+using glm::vec2;
+
+/**
+ * @brief Pixel layout of a rows x cols grid of square cells.
+ * @details Cells are centered in the window with a fixed margin around the grid, and the gap between cells is a
+ * fixed fraction of the cell pitch. A 5x5 grid in a 700x700 window gives 100px cells with 25px gaps.
+ */
+struct GridLayout {
+    /// @brief The center of cell (0, 0), which is the top left cell.
+    vec2 origin;
+
+    /// @brief Distance between the centers of neighbouring cells.
+    float pitch;
+
+    /// @brief Side length of a cell.
+    float side;
+
+    /// @brief Space between neighbouring cells.
+    float gap;
+
+    /// @brief Margin left around the grid (leaves room for text at the bottom of the window).
+    static constexpr float MARGIN = 50.0f;
+
+    /// @brief Fraction of the pitch used as the gap between cells.
+    static constexpr float GAP_RATIO = 0.2f;
+
+    /// @brief Computes the layout that fits a rows x cols grid in a width x height window.
+    static GridLayout fit(int rows, int cols, float width, float height) {
+        GridLayout layout{};
+        // n cells span n pitches minus one gap
+        float pitchX = (width - 2 * MARGIN) / (cols - GAP_RATIO);
+        float pitchY = (height - 2 * MARGIN) / (rows - GAP_RATIO);
+        layout.pitch = std::min(pitchX, pitchY);
+        layout.gap = layout.pitch * GAP_RATIO;
+        layout.side = layout.pitch - layout.gap;
+        layout.origin = vec2{width / 2 - (cols - 1) * layout.pitch / 2,
+                             height / 2 + (rows - 1) * layout.pitch / 2};
+        return layout;
+    }
+
+    /// @brief Returns the center of a cell. Rows go down the screen, columns go right.
+    vec2 cellCenter(int row, int col) const {
+        return vec2{origin.x + col * pitch, origin.y - row * pitch};
+    }
+
+    /// @brief Finds the cell under a point in constant time.
+    /// @param point The point to test (origin at the bottom left of the window)
+    /// @param rows The number of rows in the grid
+    /// @param cols The number of columns in the grid
+    /// @return The cell index (row * cols + col), or -1 if the point is outside the grid or in a gap
+    int cellAt(vec2 point, int rows, int cols) const {
+        // Offsets from the top left corner of cell (0, 0), measured right and down
+        float dx = point.x - (origin.x - side / 2);
+        float dy = (origin.y + side / 2) - point.y;
+        if (dx < 0 || dy < 0)
+            return -1;
+        int col = static_cast<int>(dx / pitch), row = static_cast<int>(dy / pitch);
+        if (row >= rows || col >= cols)
+            return -1;
+        // Inside the cell's pitch, but past its side, is the gap before the next cell
+        if (dx - col * pitch > side || dy - row * pitch > side)
+            return -1;
+        return row * cols + col;
+    }
+};
+
+#endif //GRAPHICS_GRIDLAYOUT_H
@@ -0,0 +1,27 @@
+#ifndef GRAPHICS_HASH_H
+#define GRAPHICS_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// @brief The FNV-1a offset basis, the starting value of a hash.
+constexpr uint64_t FNV1A_OFFSET = 14695981039346656037ull;
+
+/// @brief 64-bit FNV-1a hash of a block of bytes, used to key cache files by their inputs' contents.
+/// @param seed The hash to continue from, to hash several blocks as if they were one
+inline uint64_t fnv1a64(const void *data, size_t size, uint64_t seed = FNV1A_OFFSET) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+inline uint64_t fnv1a64(std::string_view text, uint64_t seed = FNV1A_OFFSET) {
+    return fnv1a64(text.data(), text.size(), seed);
+}
+
+#endif //GRAPHICS_HASH_H
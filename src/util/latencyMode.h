@@ -0,0 +1,58 @@
+#ifndef GRAPHICS_LATENCYMODE_H
+#define GRAPHICS_LATENCYMODE_H
+
+#include <string>
+
+/**
+ * @brief How the game loop trades smoothness for input latency.
+ * @details Set from the command line (see parse()). The defaults match the original loop: vsync on, input sampled
+ * straight after the previous swap, and no limit on how far the GPU queues ahead.
+ */
+struct LatencyMode {
+    /// @brief Controls how far the CPU may run ahead of the GPU.
+    enum class GpuSync {
+        /// Let the driver queue frames (usually two or three).
+        None,
+        /// Wait for the previous frame's fence before building the next one, so at most one frame is queued.
+        Fence,
+        /// glFinish() after every swap, so nothing is queued when input is sampled.
+        Finish
+    };
+
+    /// @brief Swap interval value asking for adaptive vsync (tear instead of waiting when a frame is late).
+    static constexpr int ADAPTIVE = -1;
+
+    /// @brief 0 (no vsync), 1 (vsync) or ADAPTIVE.
+    int swapInterval = 1;
+
+    /// @brief Sleep after a swap and sample input just before the next frame is built, instead of straight away.
+    bool lateInput = false;
+
+    GpuSync gpuSync = GpuSync::None;
+
+    /// @brief Redraw and swap every vsync, instead of only when something on screen changed.
+    bool continuous = false;
+
+    /// @brief Applies one command line flag.
+    /// @details Accepts --swap=0|1|adaptive, --gpu-sync=none|fence|finish, --late-input, --continuous, and
+    /// --low-latency (shorthand for --late-input --gpu-sync=finish).
+    /// @return false if the flag is not recognised
+    bool parse(const std::string &flag) {
+        if (flag == "--swap=0") swapInterval = 0;
+        else if (flag == "--swap=1") swapInterval = 1;
+        else if (flag == "--swap=adaptive") swapInterval = ADAPTIVE;
+        else if (flag == "--gpu-sync=none") gpuSync = GpuSync::None;
+        else if (flag == "--gpu-sync=fence") gpuSync = GpuSync::Fence;
+        else if (flag == "--gpu-sync=finish") gpuSync = GpuSync::Finish;
+        else if (flag == "--late-input") lateInput = true;
+        else if (flag == "--continuous") continuous = true;
+        else if (flag == "--low-latency") {
+            lateInput = true;
+            gpuSync = GpuSync::Finish;
+        }
+        else return false;
+        return true;
+    }
+};
+
+#endif //GRAPHICS_LATENCYMODE_H
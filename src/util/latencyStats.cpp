@@ -0,0 +1,43 @@
+#include "latencyStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+LatencyStats::LatencyStats(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {
+    samples.reserve(this->capacity);
+}
+
+void LatencyStats::add(double seconds) {
+    if (samples.size() < capacity) {
+        samples.push_back(seconds);
+    } else {
+        samples[next] = seconds;
+        next = (next + 1) % capacity;
+    }
+}
+
+size_t LatencyStats::count() const {
+    return samples.size();
+}
+
+double LatencyStats::percentile(double p) const {
+    if (samples.empty())
+        return 0;
+    // Nearest rank: the smallest sample with at least p% of the samples at or below it
+    size_t rank = static_cast<size_t>(std::ceil(p / 100 * samples.size()));
+    size_t index = std::clamp<size_t>(rank, 1, samples.size()) - 1;
+    std::vector<double> sorted(samples);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+void LatencyStats::print(const std::string &name) const {
+    if (samples.empty()) {
+        std::printf("%s: no samples\n", name.c_str());
+        return;
+    }
+    std::printf("%s over %zu samples: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms\n", name.c_str(),
+                samples.size(), percentile(50) * 1e3, percentile(95) * 1e3, percentile(99) * 1e3,
+                *std::max_element(samples.begin(), samples.end()) * 1e3);
+}
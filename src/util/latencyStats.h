@@ -0,0 +1,40 @@
+#ifndef GRAPHICS_LATENCYSTATS_H
+#define GRAPHICS_LATENCYSTATS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Collects latency samples (in seconds) and reports their percentiles.
+ * @details Keeps the most recent samples in a ring buffer allocated up front, so recording never allocates.
+ */
+class LatencyStats {
+public:
+    /// @brief The number of samples kept by default.
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    /// @brief Construct a collector that keeps the last capacity samples.
+    explicit LatencyStats(size_t capacity = DEFAULT_CAPACITY);
+
+    /// @brief Records one sample, replacing the oldest once the buffer is full.
+    void add(double seconds);
+
+    size_t count() const;
+
+    /// @brief Returns the p-th percentile (0 to 100) of the samples, using the nearest-rank method.
+    /// @return The percentile in seconds, or 0 if there are no samples
+    double percentile(double p) const;
+
+    /// @brief Prints the sample count and the p50, p95, p99 and maximum in milliseconds.
+    void print(const std::string &name) const;
+
+private:
+    std::vector<double> samples;
+    size_t capacity;
+
+    /// @brief Where the next sample goes once the buffer is full.
+    size_t next = 0;
+};
+
+#endif //GRAPHICS_LATENCYSTATS_H
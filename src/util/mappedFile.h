@@ -0,0 +1,45 @@
+#ifndef GRAPHICS_MAPPEDFILE_H
+#define GRAPHICS_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief A read-only memory-mapped file.
+ * @details The file stays mapped for the lifetime of the object, so pointers returned by data() are only valid until
+ * it is destroyed. Pages are loaded by the OS on first access, so mapping a large file is cheap.
+ */
+class MappedFile {
+public:
+    /// @brief Construct an empty (unmapped) MappedFile.
+    MappedFile() = default;
+
+    /// @brief Maps a file. Check isOpen() to see whether it worked.
+    explicit MappedFile(const std::string &path);
+
+    /// @brief Unmaps the file.
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    bool isOpen() const;
+    const unsigned char *data() const;
+    size_t size() const;
+
+private:
+    const unsigned char *bytes = nullptr;
+    size_t length = 0;
+
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#endif
+
+    /// @brief Unmaps the file and resets to the empty state.
+    void close();
+};
+
+#endif //GRAPHICS_MAPPEDFILE_H
@@ -0,0 +1,128 @@
+#include "resourcePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+Resource::Resource(const unsigned char *data, size_t size) : bytes(data), length(size) {}
+
+Resource::Resource(MappedFile file) : file(std::move(file)) {
+    bytes = this->file.data();
+    length = this->file.size();
+}
+
+Resource::Resource(Resource &&other) noexcept
+        : file(std::move(other.file)), bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)) {}
+
+Resource &Resource::operator=(Resource &&other) noexcept {
+    if (this != &other) {
+        file = std::move(other.file);
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+bool Resource::isOpen() const {
+    return bytes != nullptr;
+}
+
+const unsigned char *Resource::data() const {
+    return bytes;
+}
+
+size_t Resource::size() const {
+    return length;
+}
+
+ResourcePack::ResourcePack(const std::string &path) : file(path) {
+    if (!file.isOpen() || file.size() < sizeof(Header))
+        return;
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.count > (file.size() - sizeof(Header)) / sizeof(Entry)) {
+        std::cout << "ERROR::RESOURCES: Invalid resource pack " << path << std::endl;
+        return;
+    }
+
+    // Check every entry once here, so lookups can trust the index
+    const auto *index = reinterpret_cast<const Entry *>(file.data() + sizeof(Header));
+    for (uint32_t i = 0; i < header.count; i++) {
+        const Entry &entry = index[i];
+        if (uint64_t(entry.nameOffset) + entry.nameLength > file.size() || entry.offset > file.size() ||
+            entry.size > file.size() - entry.offset) {
+            std::cout << "ERROR::RESOURCES: Invalid resource pack " << path << std::endl;
+            return;
+        }
+    }
+    entries = index;
+    count = header.count;
+}
+
+bool ResourcePack::isOpen() const {
+    return entries != nullptr;
+}
+
+std::string_view ResourcePack::name(const Entry &entry) const {
+    return {reinterpret_cast<const char *>(file.data()) + entry.nameOffset, entry.nameLength};
+}
+
+Resource ResourcePack::find(std::string_view resource) const {
+    // entries are sorted by name, so this is a binary search
+    const Entry *end = entries + count;
+    const Entry *entry = std::lower_bound(entries, end, resource, [this](const Entry &e, std::string_view n) {
+        return name(e) < n;
+    });
+    if (entry == end || name(*entry) != resource)
+        return {};
+    return {file.data() + entry->offset, static_cast<size_t>(entry->size)};
+}
+
+static std::string &executablePath() {
+    static std::string path;
+    return path;
+}
+
+void ResourcePack::setExecutablePath(const std::string &path) {
+    executablePath() = path;
+}
+
+const ResourcePack &ResourcePack::shared() {
+    static const ResourcePack pack = [] {
+        // next to the executable first, so an installed or copied build finds its own pack
+        if (!executablePath().empty()) {
+            std::filesystem::path besideExecutable = std::filesystem::path(executablePath()).parent_path() / "resources.pak";
+            ResourcePack found(besideExecutable.string());
+            if (found.isOpen())
+                return found;
+        }
+#ifdef LIGHTS_OUT_RESOURCE_PACK
+        ResourcePack built(LIGHTS_OUT_RESOURCE_PACK);
+        if (built.isOpen())
+            return built;
+#endif
+        return ResourcePack();
+    }();
+    return pack;
+}
+
+Resource ResourcePack::open(std::string_view name) {
+    const ResourcePack &pack = shared();
+    if (pack.isOpen()) {
+        Resource resource = pack.find(name);
+        if (resource.isOpen())
+            return resource;
+    }
+
+    // fall back to the loose file, e.g. when running without building the pack
+    MappedFile loose(std::string(PROJECT_SOURCE_DIR "/res/") + std::string(name));
+    if (!loose.isOpen()) {
+        std::cout << "ERROR::RESOURCES: Failed to open resource " << name << std::endl;
+        return {};
+    }
+    return Resource(std::move(loose));
+}
@@ -0,0 +1,100 @@
+#ifndef GRAPHICS_RESOURCEPACK_H
+#define GRAPHICS_RESOURCEPACK_H
+
+#include "mappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief A read-only view of one resource's bytes.
+ * @details Points into the memory-mapped resource pack (no copy), or owns the mapping of a loose file when the
+ * resource came from res/ instead. Either way the bytes stay valid for the lifetime of the Resource.
+ */
+class Resource {
+public:
+    /// @brief Construct an empty (missing) Resource.
+    Resource() = default;
+
+    /// @brief A view of bytes owned elsewhere (the resource pack, which stays mapped until exit).
+    Resource(const unsigned char *data, size_t size);
+
+    /// @brief Takes over the mapping of a loose file.
+    explicit Resource(MappedFile file);
+
+    Resource(const Resource &) = delete;
+    Resource &operator=(const Resource &) = delete;
+    Resource(Resource &&other) noexcept;
+    Resource &operator=(Resource &&other) noexcept;
+
+    bool isOpen() const;
+    const unsigned char *data() const;
+    size_t size() const;
+
+private:
+    MappedFile file;
+    const unsigned char *bytes = nullptr;
+    size_t length = 0;
+};
+
+/**
+ * @brief The files of res/ packed into one indexed archive, built by tools/packResources.cpp.
+ * @details The pack is mapped once and every resource is a view into it, so loading a shader or font is a lookup
+ * instead of a file open. Layout: a Header, then Header::count Entries sorted by name, then the names, then the data
+ * of each resource (16-byte aligned). Offsets are from the start of the file.
+ *
+ * The pack is looked for next to the executable, then in the build directory it was made in. If neither exists the
+ * loose files in the source tree's res/ are used, so running without the pack still works.
+ */
+class ResourcePack {
+public:
+    struct Header {
+        char magic[4];
+        uint32_t count;
+    };
+
+    struct Entry {
+        uint32_t nameOffset, nameLength;
+        uint64_t offset, size;
+    };
+
+    static constexpr char MAGIC[4] = {'L', 'O', 'P', '1'};
+
+    /// @brief Data offsets are aligned to this, so resources can be read as any type.
+    static constexpr uint64_t ALIGNMENT = 16;
+
+    /// @brief Construct an empty (unopened) ResourcePack.
+    ResourcePack() = default;
+
+    /// @brief Maps and validates a pack. Check isOpen() to see whether it worked.
+    explicit ResourcePack(const std::string &path);
+
+    bool isOpen() const;
+
+    /// @brief Looks up a resource by its path under res/ (e.g. "shaders/shape.vert").
+    /// @return A view into the pack, or an empty Resource if it is not in the pack
+    Resource find(std::string_view name) const;
+
+    /// @brief Records the executable's path (argv[0]), so the pack next to it is found from any working directory.
+    /// @details Call before the first open().
+    static void setExecutablePath(const std::string &path);
+
+    /// @brief Opens a resource from the pack, or from the loose file in res/ if there is no pack or it is missing.
+    /// @details Safe on any thread; the pack is mapped on first use.
+    static Resource open(std::string_view name);
+
+private:
+    MappedFile file;
+    const Entry *entries = nullptr;
+    uint32_t count = 0;
+
+    /// @brief Returns the pack found next to the executable or in the build directory.
+    static const ResourcePack &shared();
+
+    /// @brief The name of an entry, as stored in the name table.
+    std::string_view name(const Entry &entry) const;
+};
+
+#endif //GRAPHICS_RESOURCEPACK_H
@@ -0,0 +1,31 @@
+#include "startupProfile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    // Initialized with the other globals, before main() runs
+    const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+}
+
+double StartupProfile::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - processStart).count();
+}
+
+void StartupProfile::record(const std::string &stage, const char *thread, double begin, double end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stages.push_back(Stage{stage, thread, begin, end});
+}
+
+void StartupProfile::print(double firstFrame) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Stage> sorted(stages);
+    std::sort(sorted.begin(), sorted.end(), [](const Stage &a, const Stage &b) { return a.begin < b.begin; });
+
+    std::printf("Time to first frame: %.1f ms\n", firstFrame * 1e3);
+    for (const Stage &stage : sorted) {
+        std::printf("  %-10s %-7s %7.1f -> %7.1f ms (%.1f ms)\n", stage.name.c_str(), stage.thread,
+                    stage.begin * 1e3, stage.end * 1e3, (stage.end - stage.begin) * 1e3);
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef GRAPHICS_STARTUPPROFILE_H
+#define GRAPHICS_STARTUPPROFILE_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Records how long each startup stage took, on whichever thread it ran, for a time-to-first-frame report.
+ * @details Times are seconds since the process started (taken during static initialization, before main()).
+ */
+class StartupProfile {
+public:
+    /// @brief Seconds since the process started.
+    static double now();
+
+    /// @brief Records a stage. Safe to call from any thread.
+    /// @param stage The stage's name
+    /// @param thread Where it ran (e.g. "main" or "worker")
+    /// @param begin When it started, from now()
+    /// @param end When it finished, from now()
+    void record(const std::string &stage, const char *thread, double begin, double end);
+
+    /// @brief Prints the time to the first frame, and when each stage started and finished.
+    void print(double firstFrame) const;
+
+private:
+    struct Stage {
+        std::string name;
+        const char *thread;
+        double begin, end;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Stage> stages;
+};
+
+#endif //GRAPHICS_STARTUPPROFILE_H
@@ -0,0 +1,44 @@
+#ifndef GRAPHICS_TEXTBUFFER_H
+#define GRAPHICS_TEXTBUFFER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+/**
+ * @brief Builds short strings (e.g. "Moves: 12") in a fixed buffer, without allocating.
+ * @details Text past the capacity is cut off.
+ */
+class TextBuffer {
+public:
+    static constexpr size_t CAPACITY = 128;
+
+    TextBuffer &operator<<(std::string_view text) {
+        size_t count = text.size() < CAPACITY - length ? text.size() : CAPACITY - length;
+        std::memcpy(data + length, text.data(), count);
+        length += count;
+        return *this;
+    }
+
+    /// @brief Appends an integer in decimal, formatted with std::to_chars.
+    TextBuffer &operator<<(long long value) {
+        std::to_chars_result result = std::to_chars(data + length, data + CAPACITY, value);
+        if (result.ec == std::errc())
+            length = static_cast<size_t>(result.ptr - data);
+        return *this;
+    }
+
+    TextBuffer &operator<<(int value)           { return *this << static_cast<long long>(value); }
+    TextBuffer &operator<<(unsigned long value) { return *this << static_cast<long long>(value); }
+
+    void clear() { length = 0; }
+
+    std::string_view view() const { return {data, length}; }
+
+private:
+    char data[CAPACITY];
+    size_t length = 0;
+};
+
+#endif //GRAPHICS_TEXTBUFFER_H
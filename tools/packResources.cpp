@@ -0,0 +1,93 @@
+// Packs every file under a resource directory into one indexed archive (see ResourcePack for the layout).
+// Run by the build: packResources <output.pak> <res directory>. Resources are named by their path under the
+// directory, with forward slashes (e.g. "shaders/shape.vert").
+
+#include "../src/util/resourcePack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct PackedFile {
+    std::string name;
+    std::vector<char> data;
+};
+
+static uint64_t align(uint64_t offset) {
+    return (offset + ResourcePack::ALIGNMENT - 1) / ResourcePack::ALIGNMENT * ResourcePack::ALIGNMENT;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <output.pak> <resource directory>\n", argv[0]);
+        return 1;
+    }
+    fs::path root = argv[2];
+
+    std::vector<PackedFile> files;
+    std::error_code error;
+    for (const fs::directory_entry &entry : fs::recursive_directory_iterator(root, error)) {
+        if (!entry.is_regular_file())
+            continue;
+        std::ifstream in(entry.path(), std::ios::binary);
+        PackedFile file{fs::relative(entry.path(), root).generic_string(),
+                        std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>())};
+        if (!in.good() && !in.eof()) {
+            std::fprintf(stderr, "failed to read %s\n", entry.path().string().c_str());
+            return 1;
+        }
+        files.push_back(std::move(file));
+    }
+    if (error) {
+        std::fprintf(stderr, "failed to list %s: %s\n", root.string().c_str(), error.message().c_str());
+        return 1;
+    }
+
+    // sorted, so ResourcePack::find() can binary search the index
+    std::sort(files.begin(), files.end(), [](const PackedFile &a, const PackedFile &b) { return a.name < b.name; });
+
+    ResourcePack::Header header{};
+    std::memcpy(header.magic, ResourcePack::MAGIC, sizeof(ResourcePack::MAGIC));
+    header.count = static_cast<uint32_t>(files.size());
+
+    // header, index and names first, then each file's data at an aligned offset
+    std::vector<ResourcePack::Entry> index(files.size());
+    uint64_t offset = sizeof(header) + sizeof(ResourcePack::Entry) * files.size();
+    for (size_t i = 0; i < files.size(); i++) {
+        index[i].nameOffset = static_cast<uint32_t>(offset);
+        index[i].nameLength = static_cast<uint32_t>(files[i].name.size());
+        offset += files[i].name.size();
+    }
+    for (size_t i = 0; i < files.size(); i++) {
+        offset = align(offset);
+        index[i].offset = offset;
+        index[i].size = files[i].data.size();
+        offset += files[i].data.size();
+    }
+
+    std::ofstream out(argv[1], std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(index.data()), static_cast<std::streamsize>(sizeof(ResourcePack::Entry) * index.size()));
+    for (const PackedFile &file : files)
+        out.write(file.name.data(), static_cast<std::streamsize>(file.name.size()));
+    for (size_t i = 0; i < files.size(); i++) {
+        static const char padding[ResourcePack::ALIGNMENT] = {};
+        out.write(padding, static_cast<std::streamsize>(index[i].offset - static_cast<uint64_t>(out.tellp())));
+        out.write(files[i].data.data(), static_cast<std::streamsize>(files[i].data.size()));
+    }
+    if (!out) {
+        std::fprintf(stderr, "failed to write %s\n", argv[1]);
+        return 1;
+    }
+
+    std::printf("Packed %zu resources into %s (%llu bytes)\n", files.size(), argv[1],
+                static_cast<unsigned long long>(offset));
+    return 0;
+}